@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef COMPOSITOR_HPP
+#define COMPOSITOR_HPP
+
+#include "damage.hpp"
+#include "font.hpp"
+#include "pcd8544.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief How a layer combines with the layers below it.
+///        bit_or:  set pixels
+///        bit_and: keep pixels set in both
+///        bit_xor: invert pixels
+///        mask:    clear pixels
+////////////////////////////////////////////////////////////////////////////////
+enum class RasterOp
+{
+    bit_or,
+    bit_and,
+    bit_xor,
+    mask
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Full screen 1bpp layer in bank-major order. Drawing only touches
+///        the layer buffer and records damage; nothing is sent until the
+///        compositor flushes.
+////////////////////////////////////////////////////////////////////////////////
+class Layer
+{
+  public:
+    static constexpr int size{PCD8544::screen_width * PCD8544::banks};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor for a layer that can be drawn on.
+    /// @param pixels layer buffer
+    /// @param op     raster operation
+    ////////////////////////////////////////////////////////////////////////////
+    explicit Layer(std::span<std::uint8_t, size> pixels,
+        RasterOp op = RasterOp::bit_or) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor for a static layer, e.g. a background in flash.
+    ///        Drawing functions have no effect on it.
+    /// @param pixels layer image
+    /// @param op     raster operation
+    ////////////////////////////////////////////////////////////////////////////
+    explicit Layer(std::span<const std::uint8_t, size> pixels,
+        RasterOp op = RasterOp::bit_or) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Set the raster operation.
+    /// @param op raster operation
+    ////////////////////////////////////////////////////////////////////////////
+    void set_op(RasterOp op) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Show or hide the layer. Only the layer's footprint is redrawn,
+    ///        so blinking an overlay costs only the area it covers.
+    /// @param visible true to show
+    ////////////////////////////////////////////////////////////////////////////
+    void set_visible(bool visible) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Check if the layer is shown.
+    /// @return true if shown
+    ////////////////////////////////////////////////////////////////////////////
+    bool visible() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Blank the layer.
+    ////////////////////////////////////////////////////////////////////////////
+    void clear() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Set a column of eight pixels.
+    /// @param x      horizontal coordinate [0-83]
+    /// @param bank   vertical coordinate [0-5]
+    /// @param pixels pixel data
+    ////////////////////////////////////////////////////////////////////////////
+    void set_pixels(int x, int bank, std::uint8_t pixels) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Copy a window of a bank-major bitmap into the layer.
+    /// @param x          left column [0-83]
+    /// @param bank       top bank [0-5]
+    /// @param width      window width in columns
+    /// @param bank_count window height in banks
+    /// @param bmp        source bitmap, starting at the window's first byte
+    /// @param stride     source row length in bytes, 0 to repeat one row
+    ////////////////////////////////////////////////////////////////////////////
+    void draw_bitmap(int x, int bank, int width, int bank_count,
+        std::span<const std::uint8_t> bmp, int stride) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw a string into the layer, clipped at the right edge.
+    /// @param x    horizontal coordinate [0-83]
+    /// @param bank top bank [0-5]
+    /// @param s    string
+    /// @param font font
+    /// @return horizontal coordinate after the last glyph
+    ////////////////////////////////////////////////////////////////////////////
+    int draw_text(
+        int x, int bank, std::string_view s, const Font& font) noexcept;
+
+  private:
+    friend class Compositor;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Record a drawn area in the footprint and the compositor damage.
+    /// @param x          left column
+    /// @param bank       top bank
+    /// @param width      width in columns
+    /// @param bank_count height in banks
+    ////////////////////////////////////////////////////////////////////////////
+    void touch(int x, int bank, int width, int bank_count) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Record everything the layer has drawn as compositor damage, for
+    ///        changes such as visibility that affect the whole layer.
+    ////////////////////////////////////////////////////////////////////////////
+    void touch_footprint() noexcept;
+
+    const std::uint8_t* m_pixels{nullptr};
+    std::uint8_t* m_writable{nullptr};
+
+    RasterOp m_op{RasterOp::bit_or};
+    bool m_visible{true};
+
+    Damage m_footprint{};
+    Damage* m_damage{nullptr};
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Combines layers, bottom first, and sends only the damaged column
+///        ranges when flushed.
+////////////////////////////////////////////////////////////////////////////////
+class Compositor
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor. The whole screen is sent on the first flush.
+    /// @param lcd    display
+    /// @param layers layers, bottom first
+    ////////////////////////////////////////////////////////////////////////////
+    Compositor(PCD8544& lcd, std::span<Layer> layers) noexcept;
+
+    Compositor(const Compositor&)            = delete;
+    Compositor& operator=(const Compositor&) = delete;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Destructor. Detaches the layers.
+    ////////////////////////////////////////////////////////////////////////////
+    ~Compositor();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Mark the whole screen for the next flush.
+    ////////////////////////////////////////////////////////////////////////////
+    void invalidate() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Compose and send the damaged areas.
+    ////////////////////////////////////////////////////////////////////////////
+    void flush() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Get the area that will be sent on the next flush.
+    /// @return damage
+    ////////////////////////////////////////////////////////////////////////////
+    const Damage& damage() const noexcept;
+
+  private:
+    PCD8544& m_lcd;
+    std::span<Layer> m_layers;
+    Damage m_damage{};
+};
+
+
+#endif   // COMPOSITOR_HPP
@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DAMAGE_HPP
+#define DAMAGE_HPP
+
+#include <array>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Screen area that needs to be sent, kept as one column range per
+///        bank.
+////////////////////////////////////////////////////////////////////////////////
+class Damage
+{
+  public:
+    static constexpr int screen_width{84};
+    static constexpr int banks{6};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Add a rectangle, clipped to the screen.
+    /// @param x          left column
+    /// @param bank       top bank
+    /// @param width      width in columns
+    /// @param bank_count height in banks
+    ////////////////////////////////////////////////////////////////////////////
+    void add(int x, int bank, int width, int bank_count) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Add another damaged area.
+    /// @param other damage
+    ////////////////////////////////////////////////////////////////////////////
+    void add(const Damage& other) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Mark the whole screen as damaged.
+    ////////////////////////////////////////////////////////////////////////////
+    void add_all() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Forget all damage.
+    ////////////////////////////////////////////////////////////////////////////
+    void clear() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Check for damage.
+    /// @return true if nothing needs to be sent
+    ////////////////////////////////////////////////////////////////////////////
+    bool empty() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief First damaged column of a bank.
+    /// @param bank bank [0-5]
+    /// @return column, equal to end if the bank is clean
+    ////////////////////////////////////////////////////////////////////////////
+    int begin(int bank) const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief One past the last damaged column of a bank.
+    /// @param bank bank [0-5]
+    /// @return column
+    ////////////////////////////////////////////////////////////////////////////
+    int end(int bank) const noexcept;
+
+  private:
+    std::array<int, banks> m_begin{};
+    std::array<int, banks> m_end{};
+};
+
+
+#endif   // DAMAGE_HPP
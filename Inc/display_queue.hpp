@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DISPLAY_QUEUE_HPP
+#define DISPLAY_QUEUE_HPP
+
+#include "mpsc_queue.hpp"
+#include "pcd8544.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Thread-safe front end for a display. Any task or interrupt can
+///        queue drawing operations without blocking, and one display task
+///        applies them with process. Text is copied into the queue; bitmaps
+///        are referenced and must stay valid until processed.
+////////////////////////////////////////////////////////////////////////////////
+class DisplayQueue
+{
+  public:
+    static constexpr std::size_t capacity{32};
+    static constexpr std::size_t max_text{PCD8544::columns};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    /// @param lcd display, only used by the task that calls process
+    ////////////////////////////////////////////////////////////////////////////
+    explicit DisplayQueue(PCD8544& lcd) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Queue clearing the display.
+    /// @return false if the queue is full
+    ////////////////////////////////////////////////////////////////////////////
+    bool clear() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Queue printing at a text position. Processes NL, FF, and CR.
+    /// @param column horizontal coordinate [0-13]
+    /// @param row    vertical coordinate [0-5]
+    /// @param s      string, truncated to 14 characters
+    /// @return false if the queue is full
+    ////////////////////////////////////////////////////////////////////////////
+    bool print(int column, int row, std::string_view s) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Queue drawing text in the current font at a pixel column.
+    /// @param x    horizontal coordinate [0-83]
+    /// @param bank top bank [0-5]
+    /// @param s    string, truncated to 14 characters
+    /// @return false if the queue is full
+    ////////////////////////////////////////////////////////////////////////////
+    bool draw_text(int x, int bank, std::string_view s) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Queue drawing a window of a bank-major bitmap.
+    /// @param x          left column [0-83]
+    /// @param bank       top bank [0-5]
+    /// @param width      window width in columns
+    /// @param bank_count window height in banks
+    /// @param bmp        source bitmap, valid until processed
+    /// @param stride     source row length in bytes, 0 to repeat one row
+    /// @return false if the queue is full
+    ////////////////////////////////////////////////////////////////////////////
+    bool draw_bitmap(int x, int bank, int width, int bank_count,
+        std::span<const std::uint8_t> bmp, int stride) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Queue a contrast change.
+    /// @param level contrast level [49-90]
+    /// @return false if the queue is full
+    ////////////////////////////////////////////////////////////////////////////
+    bool set_contrast(int level) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Apply queued operations, then flush the display's frame
+    ///        buffer, if it has one, so the batch is sent as one frame. At
+    ///        most `capacity` operations are applied per call, so producers
+    ///        that keep pushing cannot hold the display task here. Call from
+    ///        the display task only.
+    /// @return number of operations applied
+    ////////////////////////////////////////////////////////////////////////////
+    int process() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Operations rejected because the queue was full.
+    /// @return count
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint32_t dropped() const noexcept;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Queued drawing operation.
+    ////////////////////////////////////////////////////////////////////////////
+    struct Command
+    {
+        enum class Op
+        {
+            clear,
+            print,
+            draw_text,
+            draw_bitmap,
+            set_contrast
+        };
+
+        Op op{Op::clear};
+        int x{0};
+        int y{0};
+        int width{0};
+        int bank_count{0};
+        int stride{0};
+        std::span<const std::uint8_t> bitmap{};
+        std::array<char, max_text> text{};
+        std::size_t length{0};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Queue a command, counting it as dropped if the queue is full.
+    /// @param command command
+    /// @return false if the queue is full
+    ////////////////////////////////////////////////////////////////////////////
+    bool push(const Command& command) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Make a text command.
+    /// @param op text operation
+    /// @param x  horizontal coordinate
+    /// @param y  vertical coordinate
+    /// @param s  string
+    /// @return command
+    ////////////////////////////////////////////////////////////////////////////
+    static Command text(
+        Command::Op op, int x, int y, std::string_view s) noexcept;
+
+    PCD8544& m_lcd;
+    MpscQueue<Command, capacity> m_queue{};
+    std::atomic<std::uint32_t> m_dropped{0U};
+};
+
+
+#endif   // DISPLAY_QUEUE_HPP
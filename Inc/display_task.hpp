@@ -0,0 +1,134 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DISPLAY_TASK_HPP
+#define DISPLAY_TASK_HPP
+
+#include <coroutine>
+#include <cstddef>
+
+#ifndef PCD8544_COROUTINE_FRAMES
+    #define PCD8544_COROUTINE_FRAMES 4
+#endif
+
+#ifndef PCD8544_COROUTINE_FRAME_SIZE
+    #define PCD8544_COROUTINE_FRAME_SIZE 256
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Static pool of coroutine frames, so display coroutines never touch
+///        the heap. The number and size of frames are set with the
+///        PCD8544_COROUTINE_FRAMES and PCD8544_COROUTINE_FRAME_SIZE build
+///        flags.
+////////////////////////////////////////////////////////////////////////////////
+class FramePool
+{
+  public:
+    static constexpr std::size_t frames{PCD8544_COROUTINE_FRAMES};
+    static constexpr std::size_t frame_size{PCD8544_COROUTINE_FRAME_SIZE};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Take a frame from the pool.
+    /// @param size frame size the compiler needs
+    /// @return frame, or nullptr if the pool is exhausted or size too large
+    ////////////////////////////////////////////////////////////////////////////
+    static void* allocate(std::size_t size) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Return a frame to the pool.
+    /// @param frame frame from allocate
+    ////////////////////////////////////////////////////////////////////////////
+    static void deallocate(void* frame) noexcept;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Coroutine for display work, e.g. a screen update that awaits
+///        PCD8544::flush_async. It runs as soon as it is called until its
+///        first suspension, and is resumed by the transfers it awaits. The
+///        frame comes from FramePool; if the pool is exhausted the coroutine
+///        does not run and valid returns false.
+////////////////////////////////////////////////////////////////////////////////
+class DisplayTask
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Coroutine promise.
+    ////////////////////////////////////////////////////////////////////////////
+    struct promise_type
+    {
+        DisplayTask get_return_object() noexcept;
+        static DisplayTask get_return_object_on_allocation_failure() noexcept;
+
+        std::suspend_never initial_suspend() const noexcept;
+        std::suspend_always final_suspend() const noexcept;
+        void return_void() const noexcept;
+        void unhandled_exception() const noexcept;
+
+        static void* operator new(std::size_t size) noexcept;
+        static void operator delete(void* frame) noexcept;
+    };
+
+    DisplayTask() noexcept = default;
+
+    DisplayTask(const DisplayTask&)            = delete;
+    DisplayTask& operator=(const DisplayTask&) = delete;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Move constructor.
+    /// @param other task to take over
+    ////////////////////////////////////////////////////////////////////////////
+    DisplayTask(DisplayTask&& other) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Move assignment.
+    /// @param other task to take over
+    /// @return this task
+    ////////////////////////////////////////////////////////////////////////////
+    DisplayTask& operator=(DisplayTask&& other) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Destructor. Releases the frame; a task must not be destroyed
+    ///        while a transfer it awaits is in progress.
+    ////////////////////////////////////////////////////////////////////////////
+    ~DisplayTask();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Check if the coroutine was started.
+    /// @return false if no frame could be allocated
+    ////////////////////////////////////////////////////////////////////////////
+    bool valid() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Check if the coroutine has finished.
+    /// @return true if finished or not started
+    ////////////////////////////////////////////////////////////////////////////
+    bool done() const noexcept;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    /// @param handle coroutine handle
+    ////////////////////////////////////////////////////////////////////////////
+    explicit DisplayTask(std::coroutine_handle<promise_type> handle) noexcept;
+
+    std::coroutine_handle<promise_type> m_handle{};
+};
+
+
+#endif   // DISPLAY_TASK_HPP
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef DITHER_HPP
+#define DITHER_HPP
+
+#include "pcd8544.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Converts an 8-bit grayscale image, row-major with 0 as black, to
+///        bank-major 1bpp data one bank at a time, so it can be streamed to
+///        the display without a full intermediate frame.
+////////////////////////////////////////////////////////////////////////////////
+class Dither
+{
+  public:
+    static constexpr int max_width{PCD8544::screen_width};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Conversion method.
+    ///        ordered:         8x8 Bayer threshold matrix, branch-free
+    ///        error_diffusion: fixed-point Floyd-Steinberg with a single row
+    ///                         error buffer
+    ////////////////////////////////////////////////////////////////////////////
+    enum class Method
+    {
+        ordered,
+        error_diffusion
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    /// @param gray   grayscale image, width bytes per row
+    /// @param width  width in pixels [1-84]
+    /// @param height height in pixels
+    /// @param method ordered or error diffusion
+    ////////////////////////////////////////////////////////////////////////////
+    Dither(std::span<const std::uint8_t> gray, int width, int height,
+        Method method) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Number of banks in the output.
+    /// @return banks
+    ////////////////////////////////////////////////////////////////////////////
+    int banks() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Convert the next bank. Rows past the bottom of the image are
+    ///        left blank.
+    /// @param out width bytes of bank-major output
+    /// @return false if all banks have been converted
+    ////////////////////////////////////////////////////////////////////////////
+    bool next(std::span<std::uint8_t> out) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Start again from the top bank.
+    ////////////////////////////////////////////////////////////////////////////
+    void reset() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Convert the remaining banks and draw each as it is produced.
+    /// @param lcd  display
+    /// @param x    left column [0-83]
+    /// @param bank top bank [0-5]
+    ////////////////////////////////////////////////////////////////////////////
+    void draw(PCD8544& lcd, int x, int bank) noexcept;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Convert a bank with the Bayer matrix.
+    /// @param out width bytes of output
+    ////////////////////////////////////////////////////////////////////////////
+    void ordered(std::span<std::uint8_t> out) const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Convert a bank with Floyd-Steinberg error diffusion.
+    /// @param out width bytes of output
+    ////////////////////////////////////////////////////////////////////////////
+    void diffuse(std::span<std::uint8_t> out) noexcept;
+
+    std::span<const std::uint8_t> m_gray;
+    int m_width{0};
+    int m_height{0};
+    Method m_method{Method::ordered};
+    int m_bank{0};
+
+    // error carried to the next row, offset by one column on each side
+    std::array<std::int16_t, max_width + 2> m_error{};
+};
+
+
+#endif   // DITHER_HPP
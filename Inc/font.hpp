@@ -0,0 +1,537 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FONT_HPP
+#define FONT_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Bitmap font. Each glyph is stored as `banks` rows of column bytes,
+///        top row first, so fonts taller than one bank (16, 24 or 32 pixels)
+///        are drawn as one burst per bank row.
+///
+///        Fixed width fonts store every glyph `width` columns wide.
+///        Proportional fonts store each glyph packed to its own width, listed
+///        in `widths`, with the bitmap offset of every `index_stride`-th glyph
+///        in `index`.
+///        Glyphs are followed by `spacing` blank columns when drawn.
+///
+///        Characters `first` to `first + count - 1` map to glyphs in order,
+///        or through `map` for subset fonts. Anything else is drawn with the
+///        `fallback` glyph, if there is one.
+////////////////////////////////////////////////////////////////////////////////
+struct Font
+{
+    static constexpr int index_stride{8};
+    static constexpr std::uint8_t unmapped{0xFFU};
+
+    std::span<const std::uint8_t> bitmap;
+    int width{0};
+    int banks{1};
+    unsigned char first{0};
+    int count{0};
+
+    std::span<const std::uint8_t> widths{};
+    std::span<const std::uint16_t> index{};
+    int spacing{0};
+
+    std::span<const std::uint8_t> map{};
+    int fallback{-1};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Check for a proportional font.
+    /// @return true if glyphs have individual widths
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr bool proportional() const noexcept
+    {
+        return !widths.empty();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Find the glyph for a character.
+    /// @param c character
+    /// @return glyph number, or -1 if the font has no glyph for it
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr int glyph_index(const unsigned char c) const noexcept
+    {
+        const int n{c - first};
+        if((n < 0) || (n >= count))
+            return fallback;
+
+        if(map.empty())
+            return n;
+
+        const auto g = map[static_cast<std::size_t>(n)];
+        return (g == unmapped) ? fallback : g;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Width of a glyph, excluding spacing.
+    /// @param c character
+    /// @return width in columns, 0 for missing glyphs in proportional fonts
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr int glyph_width(const unsigned char c) const noexcept
+    {
+        if(!proportional())
+            return width;
+
+        const int g{glyph_index(c)};
+        return (g < 0) ? 0 : widths[static_cast<std::size_t>(g)];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Horizontal advance of a glyph, including spacing.
+    /// @param c character
+    /// @return advance in columns
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr int advance(const unsigned char c) const noexcept
+    {
+        return glyph_width(c) + spacing;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Look up a glyph.
+    /// @param c character
+    /// @return glyph bytes, or an empty span if the font has no such glyph
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr std::span<const std::uint8_t> glyph(
+        const unsigned char c) const noexcept
+    {
+        const int g{glyph_index(c)};
+        if(g < 0)
+            return {};
+
+        if(!proportional())
+        {
+            const auto size = static_cast<std::size_t>(width * banks);
+            return bitmap.subspan(static_cast<std::size_t>(g) * size, size);
+        }
+
+        // at most index_stride - 1 widths to add up past the indexed glyph
+        const int base{g - (g % index_stride)};
+        std::size_t offset{
+            index[static_cast<std::size_t>(base / index_stride)]};
+        for(int i{base}; i != g; ++i)
+        {
+            const int w{widths[static_cast<std::size_t>(i)]};
+            offset += static_cast<std::size_t>(w * banks);
+        }
+
+        const int w{widths[static_cast<std::size_t>(g)]};
+        return bitmap.subspan(offset, static_cast<std::size_t>(w * banks));
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Flash used by the font tables.
+    /// @return size in bytes
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr std::size_t size_bytes() const noexcept
+    {
+        return bitmap.size_bytes() + widths.size_bytes() + index.size_bytes() +
+               map.size_bytes();
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Storage for a proportional font packed at compile time.
+/// @tparam Glyphs number of glyphs
+/// @tparam Bytes  packed bitmap size
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t Glyphs, std::size_t Bytes>
+struct PackedFont
+{
+    std::array<std::uint8_t, Bytes> bitmap{};
+    std::array<std::uint8_t, Glyphs> widths{};
+    std::array<std::uint16_t,
+        (Glyphs + Font::index_stride - 1) / Font::index_stride>
+        index{};
+
+    int width{0};
+    int banks{1};
+    unsigned char first{0};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Describe the packed glyphs as a font.
+    /// @param spacing blank columns drawn after each glyph
+    /// @return font
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr Font font(const int spacing = 1) const noexcept
+    {
+        return Font{bitmap, width, banks, first, static_cast<int>(Glyphs),
+            widths, index, spacing};
+    }
+};
+
+
+namespace font_detail
+{
+    // blank glyphs such as space keep a couple of columns so they still advance
+    inline constexpr int blank_width{2};
+
+    struct Columns
+    {
+        int first{0};
+        int width{0};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Find the columns of a glyph that have any pixels set.
+    /// @param font font
+    /// @param c    character
+    /// @return first inked column and width, or blank_width for empty glyphs
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr Columns inked_columns(const Font& font, const unsigned char c)
+    {
+        const auto glyph = font.glyph(c);
+        const int width{font.glyph_width(c)};
+
+        int first{width};
+        int last{-1};
+        for(int col{}; col != width; ++col)
+        {
+            for(int row{}; row != font.banks; ++row)
+            {
+                if(glyph[static_cast<std::size_t>((row * width) + col)] != 0U)
+                {
+                    first = (col < first) ? col : first;
+                    last  = col;
+                }
+            }
+        }
+
+        if(last < 0)
+            return {0, (width < blank_width) ? width : blank_width};
+
+        return {first, last - first + 1};
+    }
+}   // namespace font_detail
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Size of the packed bitmap of a font with blank columns removed.
+/// @param font fixed width source font
+/// @return bitmap size in bytes
+////////////////////////////////////////////////////////////////////////////////
+constexpr std::size_t packed_size(const Font& font)
+{
+    std::size_t size{};
+    for(int n{}; n != font.count; ++n)
+    {
+        const auto c = static_cast<unsigned char>(font.first + n);
+        size += static_cast<std::size_t>(
+            font_detail::inked_columns(font, c).width * font.banks);
+    }
+
+    return size;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Pack a fixed width font into a proportional one by removing blank
+///        leading and trailing columns from every glyph.
+/// @tparam Glyphs number of glyphs, `font.count`
+/// @tparam Bytes  packed bitmap size, `packed_size(font)`
+/// @param font fixed width source font
+/// @return packed font storage
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t Glyphs, std::size_t Bytes>
+constexpr PackedFont<Glyphs, Bytes> pack_font(const Font& font)
+{
+    PackedFont<Glyphs, Bytes> packed{};
+    packed.width = font.width;
+    packed.banks = font.banks;
+    packed.first = font.first;
+
+    std::size_t offset{};
+    for(std::size_t n{}; n != Glyphs; ++n)
+    {
+        const auto c = static_cast<unsigned char>(font.first + n);
+        const auto glyph = font.glyph(c);
+        const int width{font.glyph_width(c)};
+        const auto [first, packed_width] = font_detail::inked_columns(font, c);
+
+        if((n % Font::index_stride) == 0U)
+            packed.index[n / Font::index_stride] =
+                static_cast<std::uint16_t>(offset);
+
+        packed.widths[n] = static_cast<std::uint8_t>(packed_width);
+
+        for(int row{}; row != font.banks; ++row)
+            for(int col{}; col != packed_width; ++col)
+                packed.bitmap[offset++] = glyph[static_cast<std::size_t>(
+                    (row * width) + first + col)];
+    }
+
+    return packed;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Character set of a font subset, usable as a template argument.
+/// @tparam N string literal size, including the terminating NUL
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t N>
+struct Charset
+{
+    std::array<char, N> chars{};
+
+    constexpr Charset(const char (&s)[N]) noexcept
+    {
+        std::copy_n(s, N, chars.begin());
+    }
+
+    constexpr std::string_view view() const noexcept
+    {
+        return {chars.data(), N - 1};
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Storage for a font subset built at compile time: the glyphs that
+///        are used, in character order, and a lookup table covering the range
+///        from the lowest to the highest character in the set.
+/// @tparam Glyphs       number of glyphs
+/// @tparam Bytes        bitmap size
+/// @tparam Range        lookup table size
+/// @tparam Proportional source font is proportional
+////////////////////////////////////////////////////////////////////////////////
+template<std::size_t Glyphs, std::size_t Bytes, std::size_t Range,
+    bool Proportional>
+struct SubsetFont
+{
+    static constexpr std::size_t index_size{
+        (Glyphs + Font::index_stride - 1) / Font::index_stride};
+
+    std::array<std::uint8_t, Bytes> bitmap{};
+    std::array<std::uint8_t, Range> map{};
+    std::array<std::uint8_t, Proportional ? Glyphs : 0> widths{};
+    std::array<std::uint16_t, Proportional ? index_size : 0> index{};
+
+    int width{0};
+    int banks{1};
+    unsigned char first{0};
+    int spacing{0};
+    int fallback{-1};
+
+    std::size_t source_size{0};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Describe the subset as a font.
+    /// @return font
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr Font font() const noexcept
+    {
+        return Font{bitmap, width, banks, first, static_cast<int>(Range),
+            widths, index, spacing, map, fallback};
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Flash saved against the source font.
+    /// @return size in bytes
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr std::size_t saved_bytes() const noexcept
+    {
+        return source_size - font().size_bytes();
+    }
+};
+
+
+namespace font_detail
+{
+    struct SubsetLayout
+    {
+        std::array<bool, 256> used{};
+        std::size_t glyphs{0};
+        std::size_t bytes{0};
+        unsigned char first{0};
+        std::size_t range{0};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Work out which glyphs a subset needs.
+    /// @param font     source font
+    /// @param chars    characters printed by the application
+    /// @param fallback character drawn for anything outside the set
+    /// @return subset layout
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr SubsetLayout subset_layout(
+        const Font& font, const std::string_view chars, const char fallback)
+    {
+        SubsetLayout layout{};
+
+        const auto use = [&](const char c) {
+            const auto uc = static_cast<unsigned char>(c);
+            if((font.glyph_index(uc) >= 0) && !layout.used[uc])
+            {
+                layout.used[uc] = true;
+                ++layout.glyphs;
+                layout.bytes +=
+                    static_cast<std::size_t>(font.glyph_width(uc) * font.banks);
+            }
+        };
+
+        for(const auto c : chars)
+            use(c);
+        use(fallback);
+
+        int lowest{-1};
+        int highest{-1};
+        for(int c{}; c != static_cast<int>(layout.used.size()); ++c)
+        {
+            if(layout.used[static_cast<std::size_t>(c)])
+            {
+                lowest  = (lowest < 0) ? c : lowest;
+                highest = c;
+            }
+        }
+
+        if(lowest >= 0)
+        {
+            layout.first = static_cast<unsigned char>(lowest);
+            layout.range = static_cast<std::size_t>(highest - lowest + 1);
+        }
+
+        return layout;
+    }
+}   // namespace font_detail
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Font subset holding only the glyphs for a given character set, so
+///        the full source table is not linked into the image. Example:
+///
+///            constexpr auto& digits = font_subset<font_6x8, "0123456789.-">;
+///            static_assert(digits.saved_bytes() > 1400);
+///            lcd.set_font(digits.font());
+///
+/// @tparam Source   source font
+/// @tparam Chars    characters printed by the application
+/// @tparam Fallback character drawn for anything outside the set
+////////////////////////////////////////////////////////////////////////////////
+template<const Font& Source, Charset Chars, char Fallback = '?'>
+inline constexpr auto font_subset = [] {
+    constexpr auto layout =
+        font_detail::subset_layout(Source, Chars.view(), Fallback);
+
+    SubsetFont<layout.glyphs, layout.bytes, layout.range,
+        Source.proportional()>
+        subset{};
+
+    subset.width       = Source.width;
+    subset.banks       = Source.banks;
+    subset.first       = layout.first;
+    subset.spacing     = Source.spacing;
+    subset.source_size = Source.size_bytes();
+
+    std::size_t glyph{};
+    std::size_t offset{};
+    for(std::size_t n{}; n != layout.range; ++n)
+    {
+        const auto c = static_cast<unsigned char>(layout.first + n);
+        if(!layout.used[c])
+        {
+            subset.map[n] = Font::unmapped;
+            continue;
+        }
+
+        if(c == static_cast<unsigned char>(Fallback))
+            subset.fallback = static_cast<int>(glyph);
+
+        if constexpr(Source.proportional())
+        {
+            if((glyph % Font::index_stride) == 0U)
+                subset.index[glyph / Font::index_stride] =
+                    static_cast<std::uint16_t>(offset);
+
+            subset.widths[glyph] =
+                static_cast<std::uint8_t>(Source.glyph_width(c));
+        }
+
+        for(const auto pixels : Source.glyph(c))
+            subset.bitmap[offset++] = pixels;
+
+        subset.map[n] = static_cast<std::uint8_t>(glyph++);
+    }
+
+    return subset;
+}();
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Integer-scale a single bank glyph. The result has `scale` bank rows
+///        of `glyph.size() * scale` column bytes.
+/// @param glyph glyph column bytes
+/// @param scale scale factor [1-3]
+/// @param out   output, at least `glyph.size() * scale * scale` bytes
+////////////////////////////////////////////////////////////////////////////////
+void scale_glyph(std::span<const std::uint8_t> glyph, int scale,
+    std::span<std::uint8_t> out) noexcept;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Least recently used cache of scaled glyphs, so repeated characters
+///        are not re-expanded every frame.
+////////////////////////////////////////////////////////////////////////////////
+class GlyphCache
+{
+  public:
+    static constexpr int capacity{8};
+    static constexpr int max_scale{3};
+    static constexpr int max_glyph_width{6};
+    static constexpr int max_glyph_size{
+        max_glyph_width * max_scale * max_scale};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Get a scaled glyph, expanding it on a miss.
+    /// @param font  single bank font, at most max_glyph_width columns wide
+    /// @param c     character
+    /// @param scale scale factor [2-3]
+    /// @return scaled glyph bytes
+    ////////////////////////////////////////////////////////////////////////////
+    std::span<const std::uint8_t> get(
+        const Font& font, unsigned char c, int scale) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Drop all cached glyphs.
+    ////////////////////////////////////////////////////////////////////////////
+    void clear() noexcept;
+
+  private:
+    struct Entry
+    {
+        const std::uint8_t* bitmap{nullptr};
+        int scale{0};
+        unsigned char c{0};
+        unsigned int last_use{0};
+        std::array<std::uint8_t, max_glyph_size> data{};
+    };
+
+    std::array<Entry, capacity> m_entries{};
+    unsigned int m_clock{0};
+};
+
+
+#endif   // FONT_HPP
@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef FONT_6X8_HPP
+#define FONT_6X8_HPP
+
+#include "font.hpp"
+
+#include <array>
+#include <cstdint>
+
+
+// clang-format off
+////////////////////////////////////////////////////////////////////////////////
+inline constexpr std::array<std::uint8_t, 1536> font_6x8_bitmap
+{
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    0x00u, 0x3eu, 0x45u, 0x51u, 0x45u, 0x3eu,
+    0x00u, 0x3eu, 0x7bu, 0x6fu, 0x7bu, 0x3eu,
+    0x00u, 0x1cu, 0x3eu, 0x7cu, 0x3eu, 0x1cu,
+    0x00u, 0x18u, 0x3cu, 0x7eu, 0x3cu, 0x18u,
+    0x00u, 0x18u, 0x5eu, 0x6eu, 0x5eu, 0x18u,
+    0x00u, 0x18u, 0x5cu, 0x6eu, 0x5cu, 0x18u,
+    0x00u, 0x00u, 0x18u, 0x18u, 0x00u, 0x00u,
+    0xffu, 0xffu, 0xe7u, 0xe7u, 0xffu, 0xffu,
+    0x00u, 0x18u, 0x24u, 0x24u, 0x18u, 0x00u,
+    0xffu, 0xe7u, 0xdbu, 0xdbu, 0xe7u, 0xffu,
+    0x70u, 0x88u, 0x88u, 0x8du, 0x73u, 0x07u,
+    0x00u, 0x0eu, 0x51u, 0xf1u, 0x51u, 0x0eu,
+    0x00u, 0x60u, 0x60u, 0x3fu, 0x02u, 0x04u,
+    0x60u, 0x60u, 0x3fu, 0xc5u, 0xcau, 0x7cu,
+    0x00u, 0x2au, 0x1cu, 0x36u, 0x1cu, 0x2au,
+    0x00u, 0x3eu, 0x3eu, 0x1cu, 0x1cu, 0x08u,
+    0x00u, 0x08u, 0x1cu, 0x1cu, 0x3eu, 0x3eu,
+    0x00u, 0x14u, 0x36u, 0x7fu, 0x36u, 0x14u,
+    0x00u, 0x00u, 0x5fu, 0x00u, 0x5fu, 0x00u,
+    0x00u, 0x06u, 0x09u, 0x7fu, 0x01u, 0x7fu,
+    0x40u, 0x9au, 0xa5u, 0xa5u, 0x59u, 0x02u,
+    0x00u, 0xe0u, 0xe0u, 0xe0u, 0xe0u, 0xe0u,
+    0x00u, 0x94u, 0xb6u, 0xffu, 0xb6u, 0x94u,
+    0x00u, 0x08u, 0x0cu, 0xfeu, 0x0cu, 0x08u,
+    0x00u, 0x10u, 0x30u, 0x7fu, 0x30u, 0x10u,
+    0x08u, 0x08u, 0x08u, 0x3eu, 0x1cu, 0x08u,
+    0x08u, 0x1cu, 0x3eu, 0x08u, 0x08u, 0x08u,
+    0x00u, 0x0fu, 0x08u, 0x08u, 0x08u, 0x08u,
+    0x08u, 0x1cu, 0x08u, 0x08u, 0x1cu, 0x08u,
+    0x00u, 0x60u, 0x78u, 0x7eu, 0x78u, 0x60u,
+    0x00u, 0x06u, 0x1eu, 0x7eu, 0x1eu, 0x06u,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x5fu, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x07u, 0x00u, 0x07u, 0x00u,
+    0x00u, 0x14u, 0x7fu, 0x14u, 0x7fu, 0x14u,
+    0x00u, 0x24u, 0x2au, 0x6bu, 0x2au, 0x12u,
+    0x00u, 0x22u, 0x15u, 0x2au, 0x54u, 0x22u,
+    0x00u, 0x36u, 0x49u, 0x56u, 0x20u, 0x50u,
+    0x00u, 0x00u, 0x0bu, 0x07u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x3eu, 0x41u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x41u, 0x3eu, 0x00u,
+    0x00u, 0x08u, 0x2au, 0x1cu, 0x2au, 0x08u,
+    0x00u, 0x08u, 0x08u, 0x3eu, 0x08u, 0x08u,
+    0x00u, 0x00u, 0xa0u, 0x60u, 0x00u, 0x00u,
+    0x00u, 0x08u, 0x08u, 0x08u, 0x08u, 0x08u,
+    0x00u, 0x00u, 0x60u, 0x60u, 0x00u, 0x00u,
+    0x00u, 0x60u, 0x30u, 0x18u, 0x0cu, 0x06u,
+    0x00u, 0x3eu, 0x51u, 0x49u, 0x45u, 0x3eu,
+    0x00u, 0x00u, 0x42u, 0x7fu, 0x40u, 0x00u,
+    0x00u, 0x62u, 0x51u, 0x49u, 0x49u, 0x46u,
+    0x00u, 0x22u, 0x49u, 0x49u, 0x49u, 0x36u,
+    0x00u, 0x18u, 0x14u, 0x52u, 0x7fu, 0x50u,
+    0x00u, 0x27u, 0x45u, 0x45u, 0x45u, 0x39u,
+    0x00u, 0x3cu, 0x4au, 0x49u, 0x49u, 0x30u,
+    0x00u, 0x01u, 0x01u, 0x79u, 0x05u, 0x03u,
+    0x00u, 0x36u, 0x49u, 0x49u, 0x49u, 0x36u,
+    0x00u, 0x06u, 0x49u, 0x49u, 0x29u, 0x1eu,
+    0x00u, 0x00u, 0x6cu, 0x6cu, 0x00u, 0x00u,
+    0x00u, 0x00u, 0xacu, 0x6cu, 0x00u, 0x00u,
+    0x00u, 0x08u, 0x14u, 0x22u, 0x41u, 0x00u,
+    0x00u, 0x14u, 0x14u, 0x14u, 0x14u, 0x14u,
+    0x00u, 0x00u, 0x41u, 0x22u, 0x14u, 0x08u,
+    0x00u, 0x06u, 0x01u, 0x51u, 0x09u, 0x06u,
+    0x00u, 0x3eu, 0x41u, 0x5du, 0x55u, 0x5eu,
+    0x00u, 0x7eu, 0x11u, 0x11u, 0x11u, 0x7eu,
+    0x00u, 0x7fu, 0x49u, 0x49u, 0x49u, 0x36u,
+    0x00u, 0x3eu, 0x41u, 0x41u, 0x41u, 0x22u,
+    0x00u, 0x7fu, 0x41u, 0x41u, 0x22u, 0x1cu,
+    0x00u, 0x7fu, 0x49u, 0x49u, 0x49u, 0x41u,
+    0x00u, 0x7fu, 0x09u, 0x09u, 0x09u, 0x01u,
+    0x00u, 0x3eu, 0x41u, 0x41u, 0x51u, 0x72u,
+    0x00u, 0x7fu, 0x08u, 0x08u, 0x08u, 0x7fu,
+    0x00u, 0x00u, 0x41u, 0x7fu, 0x41u, 0x00u,
+    0x00u, 0x30u, 0x40u, 0x40u, 0x40u, 0x3fu,
+    0x00u, 0x7fu, 0x08u, 0x14u, 0x22u, 0x41u,
+    0x00u, 0x7fu, 0x40u, 0x40u, 0x40u, 0x40u,
+    0x00u, 0x7fu, 0x06u, 0x18u, 0x06u, 0x7fu,
+    0x00u, 0x7fu, 0x06u, 0x08u, 0x30u, 0x7fu,
+    0x00u, 0x3eu, 0x41u, 0x41u, 0x41u, 0x3eu,
+    0x00u, 0x7fu, 0x09u, 0x09u, 0x09u, 0x06u,
+    0x00u, 0x3eu, 0x41u, 0x51u, 0x21u, 0x5eu,
+    0x00u, 0x7fu, 0x09u, 0x09u, 0x19u, 0x66u,
+    0x00u, 0x26u, 0x49u, 0x49u, 0x49u, 0x32u,
+    0x00u, 0x01u, 0x01u, 0x7fu, 0x01u, 0x01u,
+    0x00u, 0x3fu, 0x40u, 0x40u, 0x40u, 0x3fu,
+    0x00u, 0x07u, 0x18u, 0x60u, 0x18u, 0x07u,
+    0x00u, 0x7fu, 0x20u, 0x18u, 0x20u, 0x7fu,
+    0x00u, 0x63u, 0x14u, 0x08u, 0x14u, 0x63u,
+    0x00u, 0x03u, 0x0cu, 0x78u, 0x0cu, 0x03u,
+    0x00u, 0x61u, 0x51u, 0x49u, 0x45u, 0x43u,
+    0x00u, 0x00u, 0x7fu, 0x41u, 0x41u, 0x00u,
+    0x00u, 0x06u, 0x0cu, 0x18u, 0x30u, 0x60u,
+    0x00u, 0x00u, 0x41u, 0x41u, 0x7fu, 0x00u,
+    0x00u, 0x04u, 0x02u, 0x01u, 0x02u, 0x04u,
+    0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u,
+    0x00u, 0x00u, 0x00u, 0x01u, 0x02u, 0x00u,
+    0x00u, 0x20u, 0x54u, 0x54u, 0x54u, 0x78u,
+    0x00u, 0x7fu, 0x28u, 0x44u, 0x44u, 0x38u,
+    0x00u, 0x38u, 0x44u, 0x44u, 0x44u, 0x28u,
+    0x00u, 0x38u, 0x44u, 0x44u, 0x28u, 0x7fu,
+    0x00u, 0x38u, 0x54u, 0x54u, 0x54u, 0x18u,
+    0x00u, 0x08u, 0x7eu, 0x09u, 0x01u, 0x02u,
+    0x00u, 0x18u, 0xa4u, 0xa4u, 0xa8u, 0x7cu,
+    0x00u, 0x7fu, 0x08u, 0x04u, 0x04u, 0x78u,
+    0x00u, 0x00u, 0x44u, 0x7du, 0x40u, 0x00u,
+    0x00u, 0x40u, 0x80u, 0x84u, 0x7du, 0x00u,
+    0x00u, 0x7fu, 0x10u, 0x28u, 0x44u, 0x00u,
+    0x00u, 0x00u, 0x41u, 0x7fu, 0x40u, 0x00u,
+    0x00u, 0x7cu, 0x04u, 0x78u, 0x04u, 0x78u,
+    0x00u, 0x7cu, 0x08u, 0x04u, 0x04u, 0x78u,
+    0x00u, 0x38u, 0x44u, 0x44u, 0x44u, 0x38u,
+    0x00u, 0xfcu, 0x28u, 0x44u, 0x44u, 0x38u,
+    0x00u, 0x38u, 0x44u, 0x44u, 0x28u, 0xfcu,
+    0x00u, 0x44u, 0x78u, 0x44u, 0x04u, 0x08u,
+    0x00u, 0x48u, 0x54u, 0x54u, 0x54u, 0x24u,
+    0x00u, 0x04u, 0x3fu, 0x44u, 0x40u, 0x20u,
+    0x00u, 0x3cu, 0x40u, 0x40u, 0x20u, 0x7cu,
+    0x00u, 0x1cu, 0x20u, 0x40u, 0x20u, 0x1cu,
+    0x00u, 0x3cu, 0x40u, 0x30u, 0x40u, 0x3cu,
+    0x00u, 0x44u, 0x28u, 0x10u, 0x28u, 0x44u,
+    0x00u, 0x1cu, 0xa0u, 0xa0u, 0xa0u, 0x7cu,
+    0x00u, 0x44u, 0x64u, 0x54u, 0x4cu, 0x44u,
+    0x00u, 0x08u, 0x36u, 0x41u, 0x41u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x7fu, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x41u, 0x41u, 0x36u, 0x08u,
+    0x00u, 0x02u, 0x01u, 0x02u, 0x04u, 0x02u,
+    0x00u, 0x78u, 0x44u, 0x42u, 0x44u, 0x78u,
+    0x00u, 0xbeu, 0xc1u, 0xc1u, 0x41u, 0x22u,
+    0x00u, 0x3cu, 0x41u, 0x40u, 0x21u, 0x7cu,
+    0x00u, 0x38u, 0x54u, 0x56u, 0x55u, 0x18u,
+    0x00u, 0x20u, 0x56u, 0x55u, 0x56u, 0x78u,
+    0x00u, 0x20u, 0x55u, 0x54u, 0x55u, 0x78u,
+    0x00u, 0x20u, 0x55u, 0x56u, 0x54u, 0x78u,
+    0x00u, 0x20u, 0x54u, 0x55u, 0x54u, 0x78u,
+    0x00u, 0xb8u, 0xc4u, 0xc4u, 0x44u, 0x28u,
+    0x00u, 0x38u, 0x56u, 0x55u, 0x56u, 0x18u,
+    0x00u, 0x38u, 0x55u, 0x54u, 0x55u, 0x18u,
+    0x00u, 0x38u, 0x55u, 0x56u, 0x54u, 0x18u,
+    0x00u, 0x00u, 0x45u, 0x7cu, 0x41u, 0x00u,
+    0x00u, 0x00u, 0x46u, 0x7du, 0x42u, 0x00u,
+    0x00u, 0x00u, 0x45u, 0x7eu, 0x40u, 0x00u,
+    0x00u, 0x7cu, 0x13u, 0x12u, 0x13u, 0x7cu,
+    0x00u, 0x7cu, 0x12u, 0x13u, 0x12u, 0x7cu,
+    0x00u, 0x7eu, 0x4au, 0x4bu, 0x4bu, 0x43u,
+    0x00u, 0x74u, 0x54u, 0x78u, 0x54u, 0x5cu,
+    0x00u, 0x7eu, 0x09u, 0x7eu, 0x49u, 0x49u,
+    0x00u, 0x38u, 0x46u, 0x45u, 0x46u, 0x38u,
+    0x00u, 0x38u, 0x45u, 0x44u, 0x45u, 0x38u,
+    0x00u, 0x38u, 0x45u, 0x46u, 0x44u, 0x38u,
+    0x00u, 0x3cu, 0x42u, 0x41u, 0x22u, 0x7cu,
+    0x00u, 0x3cu, 0x41u, 0x42u, 0x20u, 0x7cu,
+    0x00u, 0x1cu, 0xa1u, 0xa0u, 0xa1u, 0x7cu,
+    0x00u, 0x3cu, 0x43u, 0x42u, 0x43u, 0x3cu,
+    0x00u, 0x3eu, 0x41u, 0x40u, 0x41u, 0x3eu,
+    0x00u, 0x38u, 0x44u, 0xc6u, 0x44u, 0x28u,
+    0x00u, 0x48u, 0x7eu, 0x49u, 0x49u, 0x42u,
+    0x00u, 0x29u, 0x2au, 0xfcu, 0x2au, 0x29u,
+    0x00u, 0x7fu, 0x09u, 0x29u, 0xf6u, 0xa0u,
+    0x00u, 0x40u, 0x88u, 0x7eu, 0x09u, 0x02u,
+    0x00u, 0x20u, 0x54u, 0x56u, 0x55u, 0x78u,
+    0x00u, 0x00u, 0x44u, 0x7eu, 0x41u, 0x00u,
+    0x00u, 0x38u, 0x44u, 0x46u, 0x45u, 0x38u,
+    0x00u, 0x3cu, 0x40u, 0x42u, 0x21u, 0x7cu,
+    0x00u, 0x7cu, 0x09u, 0x05u, 0x05u, 0x78u,
+    0x00u, 0x7eu, 0x0du, 0x19u, 0x31u, 0x7eu,
+    0x00u, 0x26u, 0x29u, 0x29u, 0x27u, 0x28u,
+    0x00u, 0x26u, 0x29u, 0x29u, 0x26u, 0x00u,
+    0x00u, 0x30u, 0x48u, 0x45u, 0x40u, 0x30u,
+    0x00u, 0x78u, 0x08u, 0x08u, 0x08u, 0x08u,
+    0x08u, 0x08u, 0x08u, 0x08u, 0x78u, 0x00u,
+    0x00u, 0x17u, 0x08u, 0x04u, 0x6au, 0x58u,
+    0x00u, 0x17u, 0x08u, 0x34u, 0x22u, 0x70u,
+    0x00u, 0x00u, 0x00u, 0x7du, 0x00u, 0x00u,
+    0x08u, 0x14u, 0x22u, 0x08u, 0x14u, 0x22u,
+    0x22u, 0x14u, 0x08u, 0x22u, 0x14u, 0x08u,
+    0x11u, 0x44u, 0x11u, 0x44u, 0x11u, 0x44u,
+    0x55u, 0xaau, 0x55u, 0xaau, 0x55u, 0xaau,
+    0xeeu, 0xbbu, 0xeeu, 0xbbu, 0xeeu, 0xbbu,
+    0x00u, 0x00u, 0x00u, 0xffu, 0x00u, 0x00u,
+    0x08u, 0x08u, 0x08u, 0xffu, 0x00u, 0x00u,
+    0x14u, 0x14u, 0x14u, 0xffu, 0x00u, 0x00u,
+    0x08u, 0x08u, 0xffu, 0x00u, 0xffu, 0x00u,
+    0x08u, 0x08u, 0xf8u, 0x08u, 0xf8u, 0x00u,
+    0x14u, 0x14u, 0x14u, 0xfcu, 0x00u, 0x00u,
+    0x14u, 0x14u, 0xf7u, 0x00u, 0xffu, 0x00u,
+    0x00u, 0x00u, 0xffu, 0x00u, 0xffu, 0x00u,
+    0x14u, 0x14u, 0xf4u, 0x04u, 0xfcu, 0x00u,
+    0x14u, 0x14u, 0x17u, 0x10u, 0x1fu, 0x00u,
+    0x08u, 0x08u, 0x0fu, 0x08u, 0x0fu, 0x00u,
+    0x14u, 0x14u, 0x14u, 0x1fu, 0x00u, 0x00u,
+    0x08u, 0x08u, 0x08u, 0xf8u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x0fu, 0x08u, 0x08u,
+    0x08u, 0x08u, 0x08u, 0x0fu, 0x08u, 0x08u,
+    0x08u, 0x08u, 0x08u, 0xf8u, 0x08u, 0x08u,
+    0x00u, 0x00u, 0x00u, 0xffu, 0x08u, 0x08u,
+    0x08u, 0x08u, 0x08u, 0x08u, 0x08u, 0x08u,
+    0x08u, 0x08u, 0x08u, 0xffu, 0x08u, 0x08u,
+    0x00u, 0x00u, 0x00u, 0xffu, 0x14u, 0x14u,
+    0x00u, 0x00u, 0xffu, 0x00u, 0xffu, 0x08u,
+    0x00u, 0x00u, 0x1fu, 0x10u, 0x17u, 0x14u,
+    0x00u, 0x00u, 0xfcu, 0x04u, 0xf4u, 0x14u,
+    0x14u, 0x14u, 0x17u, 0x10u, 0x17u, 0x14u,
+    0x14u, 0x14u, 0xf4u, 0x04u, 0xf4u, 0x14u,
+    0x00u, 0x00u, 0xffu, 0x00u, 0xf7u, 0x14u,
+    0x14u, 0x14u, 0x14u, 0x14u, 0x14u, 0x14u,
+    0x14u, 0x14u, 0xf7u, 0x00u, 0xf7u, 0x14u,
+    0x14u, 0x14u, 0x14u, 0x17u, 0x14u, 0x14u,
+    0x08u, 0x08u, 0x0fu, 0x08u, 0x0fu, 0x08u,
+    0x14u, 0x14u, 0x14u, 0xf4u, 0x14u, 0x14u,
+    0x08u, 0x08u, 0xf8u, 0x08u, 0xf8u, 0x08u,
+    0x00u, 0x00u, 0x0fu, 0x08u, 0x0fu, 0x08u,
+    0x00u, 0x00u, 0x00u, 0x1fu, 0x14u, 0x14u,
+    0x00u, 0x00u, 0x00u, 0xfcu, 0x14u, 0x14u,
+    0x00u, 0x00u, 0xf8u, 0x08u, 0xf8u, 0x08u,
+    0x08u, 0x08u, 0xffu, 0x08u, 0xffu, 0x08u,
+    0x14u, 0x14u, 0x14u, 0xffu, 0x14u, 0x14u,
+    0x08u, 0x08u, 0x08u, 0x0fu, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0xf8u, 0x08u, 0x08u,
+    0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu,
+    0xf0u, 0xf0u, 0xf0u, 0xf0u, 0xf0u, 0xf0u,
+    0xffu, 0xffu, 0xffu, 0x00u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0xffu, 0xffu, 0xffu,
+    0x0fu, 0x0fu, 0x0fu, 0x0fu, 0x0fu, 0x0fu,
+    0x00u, 0x38u, 0x44u, 0x44u, 0x38u, 0x44u,
+    0x40u, 0x7cu, 0x02u, 0x4au, 0x4au, 0x34u,
+    0x00u, 0x7fu, 0x01u, 0x01u, 0x01u, 0x01u,
+    0x04u, 0x7cu, 0x04u, 0x04u, 0x7cu, 0x04u,
+    0x00u, 0x63u, 0x55u, 0x49u, 0x41u, 0x41u,
+    0x00u, 0x38u, 0x44u, 0x44u, 0x4cu, 0x34u,
+    0x00u, 0xfcu, 0x40u, 0x40u, 0x40u, 0x7cu,
+    0x00u, 0x08u, 0x04u, 0x7cu, 0x08u, 0x04u,
+    0x00u, 0x1cu, 0x63u, 0x7fu, 0x63u, 0x1cu,
+    0x00u, 0x3eu, 0x49u, 0x49u, 0x49u, 0x3eu,
+    0x00u, 0x5eu, 0x61u, 0x01u, 0x61u, 0x5eu,
+    0x00u, 0x38u, 0x46u, 0x45u, 0x45u, 0x3au,
+    0x38u, 0x44u, 0x44u, 0x38u, 0x44u, 0x38u,
+    0x00u, 0x38u, 0xc4u, 0x7cu, 0x46u, 0x38u,
+    0x00u, 0x1cu, 0x2au, 0x49u, 0x49u, 0x00u,
+    0x00u, 0x7eu, 0x01u, 0x01u, 0x01u, 0x7eu,
+    0x00u, 0x2au, 0x2au, 0x2au, 0x2au, 0x2au,
+    0x00u, 0x48u, 0x48u, 0x7eu, 0x48u, 0x48u,
+    0x00u, 0x00u, 0xc1u, 0xa2u, 0x94u, 0x88u,
+    0x00u, 0x88u, 0x94u, 0xa2u, 0xc1u, 0x00u,
+    0x00u, 0x00u, 0x00u, 0xfcu, 0x02u, 0x0cu,
+    0x00u, 0x30u, 0x40u, 0x3fu, 0x00u, 0x00u,
+    0x00u, 0x08u, 0x08u, 0x2au, 0x08u, 0x08u,
+    0x00u, 0x24u, 0x12u, 0x24u, 0x48u, 0x24u,
+    0x00u, 0x06u, 0x09u, 0x09u, 0x06u, 0x00u,
+    0x00u, 0x00u, 0x18u, 0x18u, 0x00u, 0x00u,
+    0x00u, 0x00u, 0x08u, 0x00u, 0x00u, 0x00u,
+    0x10u, 0x20u, 0x40u, 0xffu, 0x01u, 0x01u,
+    0x00u, 0x00u, 0x0fu, 0x02u, 0x01u, 0x0eu,
+    0x00u, 0x00u, 0x09u, 0x0du, 0x0au, 0x00u,
+    0x00u, 0x3cu, 0x3cu, 0x3cu, 0x3cu, 0x00u,
+    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u
+};
+// clang-format on
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Built-in 6x8 font, CP437 layout. Every glyph includes a blank
+///        leading column.
+////////////////////////////////////////////////////////////////////////////////
+inline constexpr Font font_6x8{font_6x8_bitmap, 6, 1, 0, 256};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Built-in font packed to proportional widths at compile time, with
+///        one column of spacing between glyphs.
+////////////////////////////////////////////////////////////////////////////////
+inline constexpr auto font_6x8_packed =
+    pack_font<256, packed_size(font_6x8)>(font_6x8);
+
+inline constexpr Font font_6x8_proportional{font_6x8_packed.font(1)};
+
+
+#endif   // FONT_6X8_HPP
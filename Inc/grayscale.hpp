@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef GRAYSCALE_HPP
+#define GRAYSCALE_HPP
+
+#include "pcd8544.hpp"
+
+#include <cstdint>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Split a 2bpp image into bank-major bit planes.
+/// @param gray row-major image, four pixels per byte with the leftmost pixel
+///             in the top bits, 0 as white and 3 as black
+/// @param msb  high bit plane
+/// @param lsb  low bit plane
+////////////////////////////////////////////////////////////////////////////////
+void split_planes(std::span<const std::uint8_t,
+                      PCD8544::screen_width * PCD8544::screen_height / 4>
+                      gray,
+    std::span<std::uint8_t, PCD8544::screen_width * PCD8544::banks> msb,
+    std::span<std::uint8_t, PCD8544::screen_width * PCD8544::banks> lsb)
+    noexcept;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Shows four gray levels by cycling three subframes, each pixel on
+///        for as many subframes as its level: msb | lsb, msb, msb & lsb.
+///        Each step only sends the bytes that differ from the previous
+///        subframe.
+////////////////////////////////////////////////////////////////////////////////
+class Grayscale
+{
+  public:
+    static constexpr int subframes{3};
+    static constexpr int size{PCD8544::screen_width * PCD8544::banks};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    /// @param lcd display
+    /// @param msb high bit plane
+    /// @param lsb low bit plane
+    ////////////////////////////////////////////////////////////////////////////
+    Grayscale(PCD8544& lcd, std::span<const std::uint8_t, size> msb,
+        std::span<const std::uint8_t, size> lsb) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Show a new image. The next step sends a whole subframe.
+    /// @param msb high bit plane
+    /// @param lsb low bit plane
+    ////////////////////////////////////////////////////////////////////////////
+    void set_image(std::span<const std::uint8_t, size> msb,
+        std::span<const std::uint8_t, size> lsb) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Show the next subframe. Call from a timer at three times the
+    ///        gray frame rate; about 50-60 Hz per subframe avoids visible
+    ///        flicker on most glass.
+    ////////////////////////////////////////////////////////////////////////////
+    void step() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Display data bytes sent so far, for working out the SPI clock
+    ///        a subframe rate needs.
+    /// @return bytes
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint32_t bytes_sent() const noexcept;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Pixels of a subframe.
+    /// @param subframe subframe [0-2]
+    /// @param n        byte offset
+    /// @return pixel data
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint8_t pixels(int subframe, int n) const noexcept;
+
+    PCD8544& m_lcd;
+    std::span<const std::uint8_t, size> m_msb;
+    std::span<const std::uint8_t, size> m_lsb;
+
+    int m_subframe{subframes - 1};
+    bool m_full{true};
+    std::uint32_t m_bytes_sent{0};
+};
+
+
+#endif   // GRAYSCALE_HPP
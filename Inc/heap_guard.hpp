@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef HEAP_GUARD_HPP
+#define HEAP_GUARD_HPP
+
+#include <cstdint>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Heap activity since start up. Only counted when built with the
+///        PCD8544_HEAP_GUARD flag, which replaces the global operator new and
+///        delete and hooks _sbrk; otherwise every count stays zero.
+////////////////////////////////////////////////////////////////////////////////
+struct HeapStats
+{
+    std::uint32_t allocations{0};
+    std::uint32_t frees{0};
+    std::uint32_t sbrk_calls{0};
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Read the heap counters.
+/// @return heap activity
+////////////////////////////////////////////////////////////////////////////////
+HeapStats heap_stats() noexcept;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Checks that a stretch of code does not touch the heap, e.g. the
+///        render path of a long-running unit. Example:
+///
+///            const HeapGuard guard;
+///            lcd.print(label);
+///            lcd.flush();
+///            if(!guard.clean())
+///                report_heap_use(guard.allocations());
+///
+////////////////////////////////////////////////////////////////////////////////
+class HeapGuard
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor. Takes a snapshot of the heap counters.
+    ////////////////////////////////////////////////////////////////////////////
+    HeapGuard() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Allocations since construction, including heap growth by
+    ///        malloc from C code.
+    /// @return allocations
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint32_t allocations() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Check that nothing was allocated since construction.
+    /// @return true if the heap was not used
+    ////////////////////////////////////////////////////////////////////////////
+    bool clean() const noexcept;
+
+  private:
+    HeapStats m_start{};
+};
+
+
+#endif   // HEAP_GUARD_HPP
@@ -0,0 +1,133 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Bounded lock-free queue for many producers and one consumer, after
+///        Dmitry Vyukov's bounded MPMC queue. Each cell carries a sequence
+///        number, so producers only contend on one compare-and-swap of the
+///        tail and never wait for each other or for the consumer. Safe to push
+///        from tasks and interrupts.
+/// @tparam T        element type
+/// @tparam Capacity number of elements, a power of two
+////////////////////////////////////////////////////////////////////////////////
+template<typename T, std::size_t Capacity>
+class MpscQueue
+{
+    static_assert((Capacity >= 2U) && ((Capacity & (Capacity - 1U)) == 0U),
+        "capacity must be a power of two");
+
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    ////////////////////////////////////////////////////////////////////////////
+    MpscQueue() noexcept
+    {
+        for(std::size_t n{}; n != Capacity; ++n)
+            m_cells[n].sequence.store(n, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&)            = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Add an element. Any task or interrupt may push.
+    /// @param value element
+    /// @return false if the queue is full
+    ////////////////////////////////////////////////////////////////////////////
+    bool push(const T& value) noexcept
+    {
+        auto pos = m_tail.load(std::memory_order_relaxed);
+
+        for(;;)
+        {
+            auto& cell     = m_cells[pos & mask];
+            const auto seq = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) -
+                              static_cast<std::intptr_t>(pos);
+
+            if(diff == 0)
+            {
+                // the cell is free, claim it by moving the tail past it
+                if(m_tail.compare_exchange_weak(
+                       pos, pos + 1U, std::memory_order_relaxed))
+                {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1U, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if(diff < 0)
+            {
+                // the consumer has not freed the cell yet
+                return false;
+            }
+            else
+            {
+                // another producer claimed the cell first
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Remove the oldest element. Only one task may pop.
+    /// @param value element
+    /// @return false if the queue is empty
+    ////////////////////////////////////////////////////////////////////////////
+    bool pop(T& value) noexcept
+    {
+        auto& cell = m_cells[m_head & mask];
+
+        // an element is ready once its producer has published it
+        if(cell.sequence.load(std::memory_order_acquire) != m_head + 1U)
+            return false;
+
+        value = cell.value;
+        cell.sequence.store(m_head + Capacity, std::memory_order_release);
+        ++m_head;
+
+        return true;
+    }
+
+  private:
+    static constexpr std::size_t mask{Capacity - 1U};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Element with the sequence number of the position it is for.
+    ////////////////////////////////////////////////////////////////////////////
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence{0U};
+        T value{};
+    };
+
+    std::array<Cell, Capacity> m_cells{};
+    std::atomic<std::size_t> m_tail{0U};
+    std::size_t m_head{0U};
+};
+
+
+#endif   // MPSC_QUEUE_HPP
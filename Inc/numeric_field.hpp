@@ -0,0 +1,129 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NUMERIC_FIELD_HPP
+#define NUMERIC_FIELD_HPP
+
+#include "pcd8544.hpp"
+
+#include <array>
+#include <concepts>
+#include <utility>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Right-aligned numeric readout pinned to a character cell position.
+///        Cells are as wide as the widest glyph of the display font plus its
+///        spacing, so the digits stay in place in any font. Only the
+///        characters that changed since the last update are redrawn.
+////////////////////////////////////////////////////////////////////////////////
+class NumericField
+{
+  public:
+    static constexpr int max_precision{6};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    /// @param lcd       display
+    /// @param column    horizontal coordinate of the leftmost cell, in cells
+    /// @param row       top bank [0-5]
+    /// @param width     field width in characters, including sign and point
+    /// @param precision digits after the decimal point [0-6]
+    ////////////////////////////////////////////////////////////////////////////
+    NumericField(PCD8544& lcd, int column, int row, int width,
+        int precision = 0) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Update the field with a fixed-point value.
+    /// @param value value scaled by 10^precision, e.g. 12345 for 12.345 with a
+    ///              precision of 3
+    ////////////////////////////////////////////////////////////////////////////
+    void update(long value) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Update the field with a fixed-point value of any integer type,
+    ///        so plain int readings need no cast. Values outside of long are
+    ///        shown as '#'.
+    /// @tparam T integer type
+    /// @param value value scaled by 10^precision
+    ////////////////////////////////////////////////////////////////////////////
+    template<std::integral T>
+    void update(const T value) noexcept
+    {
+        if(std::in_range<long>(value))
+            update(static_cast<long>(value));
+        else
+            show(overflow());
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Update the field with a floating point value. Float arguments
+    ///        are promoted. NaN and infinity are shown as '#', like values
+    ///        that do not fit.
+    /// @param value value, rounded to the field precision
+    ////////////////////////////////////////////////////////////////////////////
+    void update(double value) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Forget the digits on screen so the next update redraws the whole
+    ///        field, e.g. after the display was cleared.
+    ////////////////////////////////////////////////////////////////////////////
+    void invalidate() noexcept;
+
+  private:
+    using Text = std::array<char, PCD8544::columns>;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Format a fixed-point value right-aligned into the field width.
+    ///        Values that do not fit are shown as '#'.
+    /// @param value fixed-point value
+    /// @return formatted text
+    ////////////////////////////////////////////////////////////////////////////
+    Text format(long value) const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Text shown for values that cannot be displayed.
+    /// @return field filled with '#'
+    ////////////////////////////////////////////////////////////////////////////
+    Text overflow() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw the characters that differ from those on screen.
+    /// @param text formatted text
+    ////////////////////////////////////////////////////////////////////////////
+    void show(const Text& text) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw one character cell and blank what the glyph leaves empty.
+    /// @param n cell within the field
+    /// @param c character
+    ////////////////////////////////////////////////////////////////////////////
+    void draw_cell(int n, char c) noexcept;
+
+    PCD8544& m_lcd;
+
+    int m_cell_width{PCD8544::font_width};
+    int m_x{0};
+    int m_row{0};
+    int m_width{0};
+    int m_precision{0};
+
+    Text m_shown{};
+};
+
+
+#endif   // NUMERIC_FIELD_HPP
@@ -18,10 +18,15 @@
 #ifndef PCD8544_HPP
 #define PCD8544_HPP
 
+#include "damage.hpp"
+#include "font.hpp"
+#include "spi_bus.hpp"
 #include "stm32f411xe.h"
 
 #include <array>
+#include <coroutine>
 #include <cstdint>
+#include <span>
 #include <string_view>
 
 
@@ -43,18 +48,129 @@ class PCD8544
     static constexpr int rows{screen_height / font_height};
 
     ////////////////////////////////////////////////////////////////////////////
-    /// @brief Constructor.
-    /// @param spi_port SPI port
+    /// @brief RAM address auto-increment direction.
+    ////////////////////////////////////////////////////////////////////////////
+    enum class Addressing
+    {
+        horizontal,
+        vertical
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Mounting orientation of the glass.
+    ///        normal:     as wired
+    ///        rotate_180: upside down
+    ///        mirror_x:   flipped left to right
+    ///        mirror_y:   flipped top to bottom
+    ////////////////////////////////////////////////////////////////////////////
+    enum class Orientation
+    {
+        normal,
+        rotate_180,
+        mirror_x,
+        mirror_y
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Pixel column and bank where drawing continues.
+    ////////////////////////////////////////////////////////////////////////////
+    struct Position
+    {
+        int x{0};
+        int bank{0};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief What the constructor does with display RAM.
+    ///        clear:    blank the screen
+    ///        deferred: leave it for the first frame, e.g. after
+    ///                  set_frame_buffer, which sends the whole screen
+    ////////////////////////////////////////////////////////////////////////////
+    enum class Startup
+    {
+        clear,
+        deferred
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Time spent in each step of the constructor.
+    ////////////////////////////////////////////////////////////////////////////
+    struct StartupCycles
+    {
+        std::uint32_t reset{0};
+        std::uint32_t configure{0};
+        std::uint32_t first_write{0};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Background transfer that a coroutine can co_await. The transfer
+    ///        starts when awaited and the coroutine is resumed from
+    ///        SpiBus::service when it is complete.
+    ////////////////////////////////////////////////////////////////////////////
+    class Transfer
+    {
+      public:
+        ////////////////////////////////////////////////////////////////////////
+        /// @brief Check if there is anything left to send.
+        /// @return true if the transfer was already done synchronously
+        ////////////////////////////////////////////////////////////////////////
+        bool await_ready() const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////
+        /// @brief Start the transfer.
+        /// @param waiter coroutine to resume when complete
+        ////////////////////////////////////////////////////////////////////////
+        void await_suspend(std::coroutine_handle<> waiter) const noexcept;
+
+        ////////////////////////////////////////////////////////////////////////
+        /// @brief Nothing to return.
+        ////////////////////////////////////////////////////////////////////////
+        void await_resume() const noexcept;
+
+      private:
+        friend class PCD8544;
+
+        ////////////////////////////////////////////////////////////////////////
+        /// @brief Constructor.
+        /// @param lcd display with a prepared transfer, or nullptr if done
+        ////////////////////////////////////////////////////////////////////////
+        explicit Transfer(PCD8544* lcd) noexcept;
+
+        PCD8544* m_lcd{nullptr};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor. Attaches the display to a bus, which may be shared
+    ///        with other displays.
+    /// @param bus      SPI bus
     /// @param sce_port chip enable port
     /// @param sce_pin  chip enable pin
     /// @param rst_port reset port
     /// @param rst_pin  reset pin
     /// @param dc_port  mode select port
     /// @param dc_pin   mode select pin
+    /// @param startup  clear the screen now or leave it for the first frame
     ////////////////////////////////////////////////////////////////////////////
-    PCD8544(SPI_TypeDef* spi_port, GPIO_TypeDef* sce_port, unsigned int sce_pin,
+    PCD8544(SpiBus& bus, GPIO_TypeDef* sce_port, unsigned int sce_pin,
         GPIO_TypeDef* rst_port, unsigned int rst_pin, GPIO_TypeDef* dc_port,
-        unsigned int dc_pin);
+        unsigned int dc_pin, Startup startup = Startup::clear);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor that shows a splash screen instead of clearing, so
+    ///        display RAM is written once during start up.
+    /// @param bus      SPI bus
+    /// @param sce_port chip enable port
+    /// @param sce_pin  chip enable pin
+    /// @param rst_port reset port
+    /// @param rst_pin  reset pin
+    /// @param dc_port  mode select port
+    /// @param dc_pin   mode select pin
+    /// @param splash   splash screen bitmap
+    ////////////////////////////////////////////////////////////////////////////
+    PCD8544(SpiBus& bus, GPIO_TypeDef* sce_port, unsigned int sce_pin,
+        GPIO_TypeDef* rst_port, unsigned int rst_pin, GPIO_TypeDef* dc_port,
+        unsigned int dc_pin,
+        const std::array<std::uint8_t, screen_width * banks>& splash);
 
     PCD8544(const PCD8544&)            = delete;
     PCD8544& operator=(const PCD8544&) = delete;
@@ -62,7 +178,7 @@ class PCD8544
     PCD8544&& operator=(PCD8544&&)     = delete;
 
     ////////////////////////////////////////////////////////////////////////////
-    /// @brief Destructor.
+    /// @brief Destructor. Detaches the display from the bus.
     ////////////////////////////////////////////////////////////////////////////
     ~PCD8544();
 
@@ -77,6 +193,20 @@ class PCD8544
     ////////////////////////////////////////////////////////////////////////////
     void clear() noexcept;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Fill a window with one byte per column, e.g. solid black or
+    ///        horizontal stripes. Sends one address set and one repeated byte
+    ///        per bank row, and a single transfer for full width windows; no
+    ///        source buffer is needed. Clipped to the screen.
+    /// @param x          left column [0-83]
+    /// @param bank       top bank [0-5]
+    /// @param width      window width in columns
+    /// @param bank_count window height in banks
+    /// @param pattern    pixels of each column in each bank, LSB on top
+    ////////////////////////////////////////////////////////////////////////////
+    void fill(int x, int bank, int width, int bank_count,
+        std::uint8_t pattern) noexcept;
+
     ////////////////////////////////////////////////////////////////////////////
     /// @brief Set the cursor position.
     /// @param column horizontal coordinate [0-13]
@@ -97,7 +227,16 @@ class PCD8544
     void print(std::string_view s);
 
     ////////////////////////////////////////////////////////////////////////////
-    /// @brief Print a character. No processing of control codes.
+    /// @brief Print a UTF-8 string, mapping code points onto the CP437 glyphs
+    ///        of the built-in font. Malformed or unmapped characters are shown
+    ///        as '?'. Processes NL, FF, and CR.
+    /// @param s UTF-8 string
+    ////////////////////////////////////////////////////////////////////////////
+    void print_utf8(std::string_view s);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Print a character in the current font. No processing of control
+    ///        codes.
     /// @param c character
     ////////////////////////////////////////////////////////////////////////////
     void write(unsigned char c);
@@ -110,7 +249,8 @@ class PCD8544
     void set_ram_addr(int x, int y) noexcept;
 
     ////////////////////////////////////////////////////////////////////////////
-    /// @brief Set a column of eight pixels at current RAM address.
+    /// @brief Set a column of eight pixels at current RAM address, then advance
+    ///        in the current addressing mode.
     /// @param pixels pixel data
     ////////////////////////////////////////////////////////////////////////////
     void set_pixels(std::uint8_t pixels) noexcept;
@@ -122,6 +262,201 @@ class PCD8544
     void draw_bitmap(
         const std::array<std::uint8_t, screen_width * banks>& bmp) noexcept;
 
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw a window of a larger bank-major bitmap without copying.
+    ///        Sends one address set and one burst per bank row, and a single
+    ///        burst for full width windows. Clipped to the screen.
+    /// @param x          left column [0-83]
+    /// @param bank       top bank [0-5]
+    /// @param width      window width in columns
+    /// @param bank_count window height in banks
+    /// @param bmp        source bitmap, starting at the window's first byte
+    /// @param stride     source row length in bytes, 0 to repeat one row
+    ////////////////////////////////////////////////////////////////////////////
+    void draw_bitmap(int x, int bank, int width, int bank_count,
+        std::span<const std::uint8_t> bmp, int stride) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw columns of pixels with vertical addressing. Full height
+    ///        columns are sent as a single burst after one address set.
+    /// @param x          left column [0-83]
+    /// @param bank       top bank [0-5]
+    /// @param bank_count column height in banks [1-6]
+    /// @param data       bank_count bytes per column, top bank first
+    ////////////////////////////////////////////////////////////////////////////
+    void draw_columns(int x, int bank, int bank_count,
+        std::span<const std::uint8_t> data) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw a string in any font at a pixel column and bank. Glyphs
+    ///        that do not fit wrap to the next line at pixel granularity. Does
+    ///        not move the text cursor and does not process control codes.
+    /// @param x    horizontal coordinate [0-83]
+    /// @param bank top bank [0-5]
+    /// @param s    string
+    /// @param font fixed width or proportional font
+    /// @return position after the last glyph
+    ////////////////////////////////////////////////////////////////////////////
+    Position draw_text(
+        int x, int bank, std::string_view s, const Font& font) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw a string in the current font scaled by an integer factor.
+    ///        Only single bank fonts up to six columns wide are scaled.
+    /// @param x     horizontal coordinate [0-83]
+    /// @param bank  top bank [0-5]
+    /// @param s     string
+    /// @param scale scale factor [1-3]
+    /// @return position after the last glyph
+    ////////////////////////////////////////////////////////////////////////////
+    Position draw_text(
+        int x, int bank, std::string_view s, int scale) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Set the font used by print, write and scaled text. The built-in
+    ///        font is used by default unless PCD8544_NO_BUILTIN_FONT is
+    ///        defined, in which case a font must be set before printing.
+    /// @param font font, e.g. a subset from font_subset
+    ////////////////////////////////////////////////////////////////////////////
+    void set_font(const Font& font) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Get the font used by print and write.
+    /// @return font
+    ////////////////////////////////////////////////////////////////////////////
+    const Font& font() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Set the addressing mode used by set_pixels. Other drawing
+    ///        functions select the mode they need.
+    /// @param addressing horizontal or vertical
+    ////////////////////////////////////////////////////////////////////////////
+    void set_addressing(Addressing addressing) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Use a cache for scaled glyphs.
+    /// @param cache glyph cache, or nullptr to expand glyphs on every draw
+    ////////////////////////////////////////////////////////////////////////////
+    void set_glyph_cache(GlyphCache* cache) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Set the mounting orientation. Coordinates of all drawing
+    ///        functions stay in logical space; bytes are flipped as they are
+    ///        sent, so assets need no pre-rotated copy. Flipped runs cost an
+    ///        address set each, but nothing extra per byte. Content already on
+    ///        the screen is not redrawn, except from the frame buffer.
+    /// @param orientation orientation
+    ////////////////////////////////////////////////////////////////////////////
+    void set_orientation(Orientation orientation) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Defer drawing to a shadow frame buffer. Drawing then only
+    ///        updates the buffer and records the bytes that changed, and tick
+    ///        sends them at no more than the frame rate. The buffer is cleared
+    ///        and the whole screen is sent with the first frame.
+    /// @param shadow frame buffer of at least 504 bytes, or empty to send
+    ///               immediately again after flushing pending changes
+    ////////////////////////////////////////////////////////////////////////////
+    void set_frame_buffer(std::span<std::uint8_t> shadow) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Set the target frame rate for deferred drawing. The glass does
+    ///        not visibly respond much faster than 20-30 Hz.
+    /// @param fps frames per second [1-1000], 25 by default
+    ////////////////////////////////////////////////////////////////////////////
+    void set_frame_rate(int fps) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send pending changes if a frame is due, and power down when
+    ///        idle. Call periodically, e.g. from the main loop, with a free
+    ///        running millisecond count. All changes since the last frame go
+    ///        out as one transfer per bank.
+    /// @param now current time in milliseconds
+    /// @return true if a frame was sent
+    ////////////////////////////////////////////////////////////////////////////
+    bool tick(std::uint32_t now) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send pending changes now, regardless of the frame rate.
+    ////////////////////////////////////////////////////////////////////////////
+    void flush() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Number of frame periods that passed while a frame was due but
+    ///        tick was not called, e.g. because the main loop was busy.
+    /// @return missed deadlines since construction
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint32_t deadline_misses() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send pending frame buffer changes in the background. Drawing
+    ///        may continue meanwhile; it is sent with the next flush. Without
+    ///        a frame buffer, or while flipped, this flushes synchronously.
+    ///        Only one transfer per display may be awaited at a time.
+    /// @return awaitable transfer
+    ////////////////////////////////////////////////////////////////////////////
+    Transfer flush_async() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw a full screen bitmap in the background. The bitmap must
+    ///        stay valid until the transfer completes. With a frame buffer, or
+    ///        while flipped, this draws synchronously.
+    /// @param bmp bitmap
+    /// @return awaitable transfer
+    ////////////////////////////////////////////////////////////////////////////
+    Transfer draw_bitmap_async(
+        const std::array<std::uint8_t, screen_width * banks>& bmp) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Power the controller down after a period without transfers,
+    ///        measured by tick. The next transfer wakes it with one command
+    ///        burst restoring Vop, bias, temperature coefficient and display
+    ///        mode; display RAM is kept.
+    /// @param timeout     idle time in milliseconds, 0 to stay powered
+    /// @param restore_ram true to also resend the frame buffer on wake, for
+    ///                    boards that lose display RAM while powered down
+    ////////////////////////////////////////////////////////////////////////////
+    void set_idle_timeout(
+        std::uint32_t timeout, bool restore_ram = false) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Check if the controller is powered down.
+    /// @return true if powered down
+    ////////////////////////////////////////////////////////////////////////////
+    bool powered_down() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Number of times the controller was woken.
+    /// @return wakes
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint32_t wakes() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Duration of the last wake burst.
+    /// @return CPU cycles
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint32_t wake_cycles() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Total time spent powered down, as seen by tick.
+    /// @return milliseconds
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint32_t power_down_time() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Start up time breakdown: reset pulse, configuration burst, and
+    ///        the initial clear or splash screen.
+    /// @return CPU cycles per step
+    ////////////////////////////////////////////////////////////////////////////
+    const StartupCycles& startup_cycles() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Number of times the controller was reset and reconfigured after
+    ///        a bus stall. See SpiBus::set_timeout.
+    /// @return recoveries
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint32_t recoveries() const noexcept;
+
   private:
     ////////////////////////////////////////////////////////////////////////////
     /// @brief PCD8544 write mode.
@@ -133,26 +468,170 @@ class PCD8544
     };
 
     ////////////////////////////////////////////////////////////////////////////
-    /// @brief Send a byte to the display.
+    /// @brief Send a byte to the display, waking the controller first if it is
+    ///        powered down.
     /// @param type command or data
     /// @param data byte to send
     ////////////////////////////////////////////////////////////////////////////
-    void send(WriteType type, std::uint8_t data) const noexcept;
+    void send(WriteType type, std::uint8_t data) noexcept;
 
-    SPI_TypeDef* m_spi_port{nullptr};
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send a run of bytes to the display in a single chip enable cycle,
+    ///        waking the controller first if it is powered down.
+    /// @param type command or data
+    /// @param data bytes to send
+    ////////////////////////////////////////////////////////////////////////////
+    void send(WriteType type, std::span<const std::uint8_t> data) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send display data for a logical RAM address with the current
+    ///        orientation applied, splitting it into runs that are contiguous
+    ///        in physical RAM. Each run is one transaction with its address.
+    /// @param x    logical horizontal coordinate [0-83]
+    /// @param y    logical vertical coordinate [0-5]
+    /// @param mode addressing mode the controller is in
+    /// @param data pixel data
+    ////////////////////////////////////////////////////////////////////////////
+    void send_oriented(int x, int y, std::uint8_t mode,
+        std::span<const std::uint8_t> data) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send one byte repeatedly at a RAM address, after an address
+    ///        set, in horizontal addressing mode.
+    /// @param x     horizontal RAM address [0-83]
+    /// @param y     vertical RAM address [0-5]
+    /// @param data  byte
+    /// @param count number of times to send it
+    ////////////////////////////////////////////////////////////////////////////
+    void send_repeated(int x, int y, std::uint8_t data, int count) noexcept;
 
-    GPIO_TypeDef* m_sce_port{nullptr};
-    unsigned int m_sce_pin{0};
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send display data and advance the tracked RAM address in the
+    ///        current addressing mode.
+    /// @param data pixel data
+    ////////////////////////////////////////////////////////////////////////////
+    void emit(std::span<const std::uint8_t> data) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Write display data to the shadow frame buffer at the tracked RAM
+    ///        address, recording changed bytes as pending damage.
+    /// @param data pixel data
+    ////////////////////////////////////////////////////////////////////////////
+    void store(std::span<const std::uint8_t> data) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Switch addressing mode if it differs from the current one.
+    /// @param mode HORIZONTAL or VERTICAL
+    ////////////////////////////////////////////////////////////////////////////
+    void select_addressing(std::uint8_t mode) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Set RAM address unless the controller is already there.
+    /// @param x horizontal coordinate [0-83]
+    /// @param y vertical coordinate [0-5]
+    ////////////////////////////////////////////////////////////////////////////
+    void move_to(int x, int y) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Clear the spacing columns after a glyph.
+    /// @param x           horizontal coordinate [0-83]
+    /// @param bank        top bank [0-5]
+    /// @param width       spacing in columns
+    /// @param glyph_banks glyph height in banks
+    ////////////////////////////////////////////////////////////////////////////
+    void draw_spacing(int x, int bank, int width, int glyph_banks) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Start the next part of a background transfer, or resume the
+    ///        waiting coroutine when there is none left.
+    ////////////////////////////////////////////////////////////////////////////
+    void continue_async() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send the whole controller configuration in one command burst:
+    ///        Vop, temperature coefficient, bias and display mode.
+    ////////////////////////////////////////////////////////////////////////////
+    void configure() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Put the controller into power-down mode.
+    ////////////////////////////////////////////////////////////////////////////
+    void power_down() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Leave power-down mode and restore the controller settings.
+    ////////////////////////////////////////////////////////////////////////////
+    void wake() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Recover if the bus reported a stall since the last check.
+    ////////////////////////////////////////////////////////////////////////////
+    void check_stalls() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Reset and reconfigure the controller after a stall.
+    ////////////////////////////////////////////////////////////////////////////
+    void recover() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Bus completion callback.
+    /// @param lcd display
+    ////////////////////////////////////////////////////////////////////////////
+    static void on_transfer(void* lcd) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Background transfer in progress.
+    ////////////////////////////////////////////////////////////////////////////
+    struct Async
+    {
+        std::span<const std::uint8_t> bitmap{};
+        Damage damage{};
+        int bank{0};
+        std::uint8_t mode{HORIZONTAL};
+        bool restore{false};
+        std::array<std::uint8_t, 3> command{};
+        std::coroutine_handle<> waiter{};
+    };
+
+    SpiBus& m_bus;
+    int m_device{-1};
 
     GPIO_TypeDef* m_rst_port{nullptr};
     unsigned int m_rst_pin{0};
 
-    GPIO_TypeDef* m_dc_port{nullptr};
-    unsigned int m_dc_pin{0};
-
     int m_vop{69};   // m_vop = 3.06V + 0.06V * 69 = 7.2V
     int m_x_addr{0};
     int m_y_addr{0};
+    std::uint8_t m_addressing{HORIZONTAL};
+
+    Font m_font{};
+    GlyphCache* m_glyph_cache{nullptr};
+    Orientation m_orientation{Orientation::normal};
+    Async m_async{};
+
+    std::uint32_t m_idle_timeout{0};
+    std::uint32_t m_last_tick{0};
+    std::uint32_t m_last_active{0};
+    std::uint32_t m_wakes{0};
+    std::uint32_t m_wake_cycles{0};
+    std::uint32_t m_power_down_time{0};
+    bool m_restore_ram{false};
+    bool m_active{false};
+    bool m_powered_down{false};
+
+    StartupCycles m_startup{};
+
+    std::uint32_t m_stalls_seen{0};
+    std::uint32_t m_recoveries{0};
+
+    std::span<std::uint8_t> m_shadow{};
+    Damage m_pending{};
+    std::uint32_t m_frame_period{40};   // ms, 25 Hz
+    std::uint32_t m_next_frame{0};
+    std::uint32_t m_due{0};
+    std::uint32_t m_deadline_misses{0};
+    bool m_paced{false};
+    bool m_armed{false};
 
     // commands and flags
     static constexpr std::uint8_t NOP{0x00U};
@@ -184,7 +663,11 @@ class PCD8544
     static constexpr std::uint8_t TEMP1{0x01U};
     static constexpr std::uint8_t TEMP2{0x10U};
     static constexpr std::uint8_t TEMP3{0x11U};
+    static constexpr std::uint8_t BIAS_1_48{0x03U};
 };
 
+static_assert(Damage::screen_width == PCD8544::screen_width);
+static_assert(Damage::banks == PCD8544::banks);
+
 
 #endif   // PCD8544_HPP
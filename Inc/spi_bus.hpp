@@ -0,0 +1,374 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPI_BUS_HPP
+#define SPI_BUS_HPP
+
+#include "stm32f411xe.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief SPI peripheral shared by several devices, each with its own chip
+///        enable and mode select pins. The peripheral is enabled while at
+///        least one device is attached. Devices submit whole transactions,
+///        which the bus sends back to back, one transaction per turn, so a
+///        busy device cannot interleave with or starve the others.
+////////////////////////////////////////////////////////////////////////////////
+class SpiBus
+{
+  public:
+    static constexpr int max_devices{4};
+    static constexpr int queue_depth{4};
+    static constexpr std::size_t max_dma_length{65535U};
+    static constexpr std::size_t histogram_buckets{18U};
+
+    // twice the slowest byte: eight bits at the largest baud rate prescaler,
+    // 256, with the APB clock at 1/16 of the core clock
+    static constexpr std::uint32_t default_timeout{8U * 256U * 16U * 2U};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Order in which devices with queued transactions take turns.
+    ///        round_robin: each device in turn
+    ///        priority:    lowest priority value first, equal priorities in
+    ///                     turn
+    ////////////////////////////////////////////////////////////////////////////
+    enum class Policy
+    {
+        round_robin,
+        priority
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Pins of a device on the bus.
+    ////////////////////////////////////////////////////////////////////////////
+    struct Device
+    {
+        GPIO_TypeDef* sce_port{nullptr};
+        unsigned int sce_pin{0};
+        GPIO_TypeDef* dc_port{nullptr};
+        unsigned int dc_pin{0};
+        int priority{0};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Command bytes followed by data bytes, sent in one chip enable
+    ///        cycle. Either part may be empty. Data can be sent last byte
+    ///        first and translated through a table, e.g. to flip pixels, and
+    ///        repeated, e.g. to fill with a pattern without a source buffer.
+    ////////////////////////////////////////////////////////////////////////////
+    struct Transaction
+    {
+        std::span<const std::uint8_t> command{};
+        std::span<const std::uint8_t> data{};
+        bool reversed{false};
+        const std::array<std::uint8_t, 256>* map{nullptr};
+        std::size_t repeat{1U};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Called when an asynchronous transfer is complete, from service.
+    ////////////////////////////////////////////////////////////////////////////
+    using Completion = void (*)(void* context);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Flag wait latency and stalls. Histogram bucket n counts waits
+    ///        of 2^(n-1) to 2^n - 1 CPU cycles, bucket 0 waits that were
+    ///        already over, and the last bucket everything longer.
+    ////////////////////////////////////////////////////////////////////////////
+    struct WaitStats
+    {
+        std::uint32_t stalls{0};
+        std::uint32_t worst{0};
+        std::array<std::uint32_t, histogram_buckets> histogram{};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    /// @param spi_port SPI port
+    /// @param policy   turn order
+    ////////////////////////////////////////////////////////////////////////////
+    explicit SpiBus(
+        SPI_TypeDef* spi_port, Policy policy = Policy::round_robin) noexcept;
+
+    SpiBus(const SpiBus&)            = delete;
+    SpiBus& operator=(const SpiBus&) = delete;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Destructor. Sends queued transactions and disables the port.
+    ////////////////////////////////////////////////////////////////////////////
+    ~SpiBus();
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Add a device. Enables the port for the first device.
+    /// @param device device pins and priority
+    /// @return device number, or -1 if the bus is full
+    ////////////////////////////////////////////////////////////////////////////
+    int attach(const Device& device) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Remove a device after sending its queued transactions. Disables
+    ///        the port when the last device is removed.
+    /// @param id device number
+    ////////////////////////////////////////////////////////////////////////////
+    void detach(int id) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Queue a transaction. The bytes must stay valid until sent.
+    /// @param id          device number
+    /// @param transaction transaction
+    /// @return false if the device's queue is full
+    ////////////////////////////////////////////////////////////////////////////
+    bool submit(int id, const Transaction& transaction) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send all queued transactions in turn order. Only one task sends
+    ///        at a time: if another task is already sending, this returns at
+    ///        once and that task sends the queued transactions too.
+    ////////////////////////////////////////////////////////////////////////////
+    void drain() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Queue a transaction and return once it has been sent, along
+    ///        with any transactions that were queued before it. While another
+    ///        task is sending, this waits for it, so tasks sharing a bus
+    ///        should not starve each other, e.g. by running at one priority.
+    /// @param id          device number
+    /// @param transaction transaction
+    /// @return false if the transaction could not be queued, e.g. the device
+    ///         is not attached, and was never sent
+    ////////////////////////////////////////////////////////////////////////////
+    bool transfer(int id, const Transaction& transaction) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Number of transactions queued for a device.
+    /// @param id device number
+    /// @return transactions
+    ////////////////////////////////////////////////////////////////////////////
+    int pending(int id) const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Set the turn order.
+    /// @param policy round robin or priority
+    ////////////////////////////////////////////////////////////////////////////
+    void set_policy(Policy policy) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Start sending a transaction in the background, after anything
+    ///        queued and any background transfer already in progress. Bytes
+    ///        are fed by service, which calls done at the end. The bytes must
+    ///        stay valid until then. Called from done, the transfer follows on
+    ///        at once and queued transactions wait for thread context.
+    /// @param id          device number
+    /// @param transaction transaction
+    /// @param done        completion callback
+    /// @param context     callback argument
+    /// @return false if the device is not attached
+    ////////////////////////////////////////////////////////////////////////////
+    bool start(int id, const Transaction& transaction, Completion done,
+        void* context) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Check for a background transfer in progress.
+    /// @return true if busy
+    ////////////////////////////////////////////////////////////////////////////
+    bool busy() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Feed a background transfer while the transmit buffer has room.
+    ///        Call from the SPI interrupt handler when interrupts are enabled,
+    ///        or from a poll hook otherwise. Completion callbacks run in the
+    ///        same context.
+    ////////////////////////////////////////////////////////////////////////////
+    void service() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Choose how background transfers are fed.
+    /// @param enabled true to enable the transmit buffer empty interrupt for
+    ///                each transfer, false to rely on polling service
+    ////////////////////////////////////////////////////////////////////////////
+    void set_interrupt(bool enabled) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send repeated single bytes with a DMA stream reading one fixed
+    ///        memory address, so fills run at the SPI clock without a source
+    ///        buffer. Without a stream they are fed from the transmit buffer
+    ///        empty flag. The stream must be clocked and connected to this
+    ///        port's transmit request.
+    /// @param dma     DMA controller, nullptr to stop using DMA
+    /// @param stream  stream number [0-7]
+    /// @param channel channel selection, e.g. LL_DMA_CHANNEL_2
+    ////////////////////////////////////////////////////////////////////////////
+    void set_dma(
+        DMA_TypeDef* dma, std::uint32_t stream, std::uint32_t channel) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Set how long to wait for the port before giving up. A stalled
+    ///        transaction is dropped, the peripheral is reset and reconfigured,
+    ///        and the device's stall count goes up so its driver can recover.
+    ///        The default suits any prescaler; wait_stats shows how far it
+    ///        can be brought down for a given clock setup.
+    /// @param cycles CPU cycles allowed per byte
+    ////////////////////////////////////////////////////////////////////////////
+    void set_timeout(std::uint32_t cycles) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Number of transactions for a device that stalled.
+    /// @param id device number
+    /// @return stalls
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint32_t stalls(int id) const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Wait latency for all devices, for tuning the timeout.
+    /// @return statistics
+    ////////////////////////////////////////////////////////////////////////////
+    const WaitStats& wait_stats() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Clear the wait latency statistics.
+    ////////////////////////////////////////////////////////////////////////////
+    void reset_wait_stats() noexcept;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Attached device and its transaction ring buffer.
+    ////////////////////////////////////////////////////////////////////////////
+    struct Slot
+    {
+        Device device{};
+        bool attached{false};
+        std::array<Transaction, queue_depth> queue{};
+        int head{0};
+        int count{0};
+        std::uint32_t stalls{0};
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Choose the device whose turn it is.
+    /// @return device number, or -1 if nothing is queued
+    ////////////////////////////////////////////////////////////////////////////
+    int next() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send queued transactions in turn order until every queue is
+    ///        empty. The caller holds the bus.
+    /// @param keep true to keep holding the bus afterwards, false to release
+    ///             it together with the check that the queues are empty
+    ////////////////////////////////////////////////////////////////////////////
+    void send_queued(bool keep) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send a transaction with the chip enabled, and recover if it
+    ///        stalls.
+    /// @param slot        device
+    /// @param transaction transaction
+    ////////////////////////////////////////////////////////////////////////////
+    void run(Slot& slot, const Transaction& transaction) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send the bytes of a transaction.
+    /// @param device      device pins
+    /// @param transaction transaction
+    /// @return false if the port stalled
+    ////////////////////////////////////////////////////////////////////////////
+    bool send(const Device& device, const Transaction& transaction) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Send the fill byte with DMA.
+    /// @param count number of bytes
+    /// @return false if the stream stalled
+    ////////////////////////////////////////////////////////////////////////////
+    bool send_dma(std::size_t count) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Wait for room in the transmit buffer.
+    /// @return false on timeout
+    ////////////////////////////////////////////////////////////////////////////
+    bool wait_txe() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Wait for the last byte to be shifted out.
+    /// @return false on timeout
+    ////////////////////////////////////////////////////////////////////////////
+    bool wait_idle() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Wait for a background transfer to finish.
+    ////////////////////////////////////////////////////////////////////////////
+    void wait_async() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief End a stalled background transfer and call its completion.
+    ////////////////////////////////////////////////////////////////////////////
+    void abort_async() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Call the completion callback of a finished or aborted transfer,
+    ///        and release the bus unless the callback started another one.
+    ////////////////////////////////////////////////////////////////////////////
+    void complete() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Count a stall and reset the peripheral.
+    /// @param slot device that was being sent to
+    ////////////////////////////////////////////////////////////////////////////
+    void stall(Slot& slot) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Add a wait to the latency statistics.
+    /// @param cycles wait time
+    ////////////////////////////////////////////////////////////////////////////
+    void record(std::uint32_t cycles) noexcept;
+
+    SPI_TypeDef* m_spi_port{nullptr};
+    Policy m_policy{Policy::round_robin};
+    std::array<Slot, max_devices> m_slots{};
+    int m_last{max_devices - 1};
+    int m_users{0};
+
+    // bounded waits
+    std::uint32_t m_timeout{default_timeout};
+    WaitStats m_stats{};
+
+    // constant source transfers
+    DMA_TypeDef* m_dma{nullptr};
+    std::uint32_t m_dma_stream{0};
+    std::uint8_t m_fill{0};
+
+    // background transfer
+    Transaction m_async{};
+    Slot* m_async_slot{nullptr};
+    std::size_t m_async_index{0};
+    bool m_async_data{false};
+    Completion m_done{nullptr};
+    void* m_context{nullptr};
+    bool m_interrupt{false};
+    bool m_completing{false};
+    bool m_chained{false};
+    std::atomic<bool> m_busy{false};
+
+    // set while one task sends, so bytes from two tasks never interleave
+    std::atomic<bool> m_owned{false};
+};
+
+
+#endif   // SPI_BUS_HPP
@@ -0,0 +1,177 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPRITE_HPP
+#define SPRITE_HPP
+
+#include "pcd8544.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Screen rectangle in columns and banks, end exclusive.
+////////////////////////////////////////////////////////////////////////////////
+struct BankRect
+{
+    int x0{0};
+    int x1{0};
+    int bank0{0};
+    int bank1{0};
+
+    constexpr bool empty() const noexcept
+    {
+        return (x0 >= x1) || (bank0 >= bank1);
+    }
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Movable image drawn over the background at any pixel position.
+///        Images are bank-major, `width` columns per bank row, up to the full
+///        screen height. An optional mask of the same layout selects which
+///        pixels are opaque; without one, set pixels are drawn over the scene.
+////////////////////////////////////////////////////////////////////////////////
+class Sprite
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor. The sprite starts hidden at (0, 0).
+    /// @param image  image
+    /// @param width  width in pixels
+    /// @param height height in pixels [1-48]
+    /// @param mask   optional opacity mask
+    ////////////////////////////////////////////////////////////////////////////
+    Sprite(std::span<const std::uint8_t> image, int width, int height,
+        std::span<const std::uint8_t> mask = {}) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Move the sprite.
+    /// @param x horizontal pixel coordinate of the left edge
+    /// @param y vertical pixel coordinate of the top edge
+    ////////////////////////////////////////////////////////////////////////////
+    void move_to(int x, int y) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Change the image, e.g. for the next animation frame. The new
+    ///        image must have the same size.
+    /// @param image image
+    /// @param mask  optional opacity mask
+    ////////////////////////////////////////////////////////////////////////////
+    void set_image(std::span<const std::uint8_t> image,
+        std::span<const std::uint8_t> mask = {}) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Show or hide the sprite.
+    /// @param visible true to show
+    ////////////////////////////////////////////////////////////////////////////
+    void set_visible(bool visible) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Area covered at the current position.
+    /// @return bounding box in bank units, clipped to the screen
+    ////////////////////////////////////////////////////////////////////////////
+    BankRect bounds() const noexcept;
+
+  private:
+    friend class SpriteEngine;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw the sprite's pixels over a bank row.
+    /// @param bank bank [0-5]
+    /// @param x0   first column
+    /// @param x1   one past the last column
+    /// @param row  bank row, indexed by screen column
+    ////////////////////////////////////////////////////////////////////////////
+    void draw(int bank, int x0, int x1,
+        std::span<std::uint8_t> row) const noexcept;
+
+    std::span<const std::uint8_t> m_image;
+    std::span<const std::uint8_t> m_mask;
+    int m_width{0};
+    int m_height{0};
+    int m_banks{0};
+
+    int m_x{0};
+    int m_y{0};
+    bool m_visible{false};
+
+    bool m_changed{false};
+    bool m_shown{false};
+    BankRect m_drawn{};
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Draws sprites over a static background, repainting only where
+///        sprites changed: the union of each sprite's old and new bounding
+///        box, with overlapping rectangles merged.
+////////////////////////////////////////////////////////////////////////////////
+class SpriteEngine
+{
+  public:
+    static constexpr int max_rects{16};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    /// @param lcd        display
+    /// @param background bank-major background image
+    /// @param sprites    sprites, bottom first
+    ////////////////////////////////////////////////////////////////////////////
+    SpriteEngine(PCD8544& lcd,
+        std::span<const std::uint8_t, PCD8544::screen_width * PCD8544::banks>
+            background,
+        std::span<Sprite> sprites) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw the whole scene.
+    ////////////////////////////////////////////////////////////////////////////
+    void redraw() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Repaint the areas of sprites that moved, changed or were shown
+    ///        or hidden since the last update.
+    ////////////////////////////////////////////////////////////////////////////
+    void update() noexcept;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Add a rectangle to the damage list, merging it with any
+    ///        rectangle it overlaps.
+    /// @param rect rectangle
+    ////////////////////////////////////////////////////////////////////////////
+    void add(BankRect rect) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Compose and send a rectangle of the scene.
+    /// @param rect rectangle
+    ////////////////////////////////////////////////////////////////////////////
+    void paint(const BankRect& rect) noexcept;
+
+    PCD8544& m_lcd;
+    std::span<const std::uint8_t, PCD8544::screen_width * PCD8544::banks>
+        m_background;
+    std::span<Sprite> m_sprites;
+
+    std::array<BankRect, max_rects> m_rects{};
+    int m_rect_count{0};
+};
+
+
+#endif   // SPRITE_HPP
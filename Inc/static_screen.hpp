@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STATIC_SCREEN_HPP
+#define STATIC_SCREEN_HPP
+
+#include "font.hpp"
+#include "pcd8544.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Screen rendered at compile time into a bank-major image, so fixed
+///        menus and captions live in flash and are shown with one full screen
+///        draw_bitmap, without any font lookups at run time. Example:
+///
+///            inline constexpr auto menu_screen = StaticScreen{}
+///                .text(0, 0, "SETTINGS", font_6x8)
+///                .invert(0, 0, 84, 1)
+///                .text(6, 2, "Contrast", font_6x8)
+///                .text(6, 3, "Backlight", font_6x8)
+///                .pixels();
+///
+///            lcd.draw_bitmap(menu_screen);
+///
+///        Drawing follows PCD8544: text wraps like draw_text, and everything
+///        is clipped to the screen.
+////////////////////////////////////////////////////////////////////////////////
+class StaticScreen
+{
+  public:
+    using Pixels =
+        std::array<std::uint8_t, PCD8544::screen_width * PCD8544::banks>;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw a string at a pixel column and bank. Glyphs that do not
+    ///        fit wrap to the next line; control codes are not processed.
+    /// @param x    horizontal coordinate [0-83]
+    /// @param bank top bank [0-5]
+    /// @param s    string
+    /// @param font fixed width or proportional font
+    /// @return this screen
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr StaticScreen& text(
+        int x, int bank, const std::string_view s, const Font& font) noexcept
+    {
+        for(const auto c : s)
+        {
+            const auto uc = static_cast<unsigned char>(c);
+            const int width{font.glyph_width(uc)};
+
+            if((x + width > PCD8544::screen_width) && (x != 0))
+            {
+                x = 0;
+                bank += font.banks;
+            }
+
+            if(bank >= PCD8544::banks)
+                break;
+
+            bitmap(x, bank, width, font.banks, font.glyph(uc));
+            fill(x + width, bank, font.spacing, font.banks, 0U);
+
+            x += width + font.spacing;
+        }
+
+        return *this;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Copy a bank-major bitmap.
+    /// @param x          left column [0-83]
+    /// @param bank       top bank [0-5]
+    /// @param width      bitmap width in columns
+    /// @param bank_count bitmap height in banks
+    /// @param bmp        width bytes per bank row
+    /// @return this screen
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr StaticScreen& bitmap(const int x, const int bank, const int width,
+        const int bank_count, const std::span<const std::uint8_t> bmp) noexcept
+    {
+        if(bmp.size() < static_cast<std::size_t>(width * bank_count))
+            return *this;
+
+        for(int row{}; row != bank_count; ++row)
+        {
+            for(int col{}; col != width; ++col)
+            {
+                if(visible(x + col, bank + row))
+                    at(x + col, bank + row) =
+                        bmp[static_cast<std::size_t>((row * width) + col)];
+            }
+        }
+
+        return *this;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Fill a window with one byte per column.
+    /// @param x          left column [0-83]
+    /// @param bank       top bank [0-5]
+    /// @param width      window width in columns
+    /// @param bank_count window height in banks
+    /// @param pattern    pixels of each column in each bank, LSB on top
+    /// @return this screen
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr StaticScreen& fill(const int x, const int bank, const int width,
+        const int bank_count, const std::uint8_t pattern) noexcept
+    {
+        for(int row{}; row < bank_count; ++row)
+        {
+            for(int col{}; col < width; ++col)
+            {
+                if(visible(x + col, bank + row))
+                    at(x + col, bank + row) = pattern;
+            }
+        }
+
+        return *this;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Invert a window, e.g. to highlight a menu item.
+    /// @param x          left column [0-83]
+    /// @param bank       top bank [0-5]
+    /// @param width      window width in columns
+    /// @param bank_count window height in banks
+    /// @return this screen
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr StaticScreen& invert(const int x, const int bank, const int width,
+        const int bank_count) noexcept
+    {
+        for(int row{}; row < bank_count; ++row)
+        {
+            for(int col{}; col < width; ++col)
+            {
+                if(visible(x + col, bank + row))
+                {
+                    auto& pixels = at(x + col, bank + row);
+                    pixels       = static_cast<std::uint8_t>(~pixels);
+                }
+            }
+        }
+
+        return *this;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Rendered screen, in the layout of a full screen draw_bitmap.
+    /// @return pixels
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr const Pixels& pixels() const noexcept
+    {
+        return m_pixels;
+    }
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Check that a column and bank are on screen.
+    /// @param x    column
+    /// @param bank bank
+    /// @return true if visible
+    ////////////////////////////////////////////////////////////////////////////
+    static constexpr bool visible(const int x, const int bank) noexcept
+    {
+        return (x >= 0) && (x < PCD8544::screen_width) && (bank >= 0) &&
+               (bank < PCD8544::banks);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Byte at a column and bank.
+    /// @param x    column [0-83]
+    /// @param bank bank [0-5]
+    /// @return pixels
+    ////////////////////////////////////////////////////////////////////////////
+    constexpr std::uint8_t& at(const int x, const int bank) noexcept
+    {
+        return m_pixels[static_cast<std::size_t>(
+            (bank * PCD8544::screen_width) + x)];
+    }
+
+    Pixels m_pixels{};
+};
+
+
+#endif   // STATIC_SCREEN_HPP
@@ -0,0 +1,110 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STRIP_CHART_HPP
+#define STRIP_CHART_HPP
+
+#include "pcd8544.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Scrolling strip chart of live samples. Samples are kept in a column
+///        ring buffer. Redraws send the window one bank row at a time from a
+///        single row buffer.
+////////////////////////////////////////////////////////////////////////////////
+class StripChart
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Update style.
+    ///        scroll: newest sample at the right edge, whole chart shifts left
+    ///        sweep:  a cursor sweeps left to right, drawing the new column
+    ///                and erasing the one ahead of it
+    ////////////////////////////////////////////////////////////////////////////
+    enum class Mode
+    {
+        scroll,
+        sweep
+    };
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    /// @param lcd        display
+    /// @param x          left column [0-83]
+    /// @param bank       top bank [0-5]
+    /// @param width      chart width in columns
+    /// @param bank_count chart height in banks
+    /// @param mode       scroll or sweep
+    ////////////////////////////////////////////////////////////////////////////
+    StripChart(PCD8544& lcd, int x, int bank, int width, int bank_count,
+        Mode mode = Mode::scroll) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Add a sample and update the display.
+    /// @param value sample height in pixels above the bottom of the chart,
+    ///              clamped to the chart height
+    ////////////////////////////////////////////////////////////////////////////
+    void push(int value) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw the whole chart, e.g. after the display was cleared.
+    ////////////////////////////////////////////////////////////////////////////
+    void redraw() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Drop all samples and blank the chart.
+    ////////////////////////////////////////////////////////////////////////////
+    void clear() noexcept;
+
+  private:
+    using Column = std::array<std::uint8_t, PCD8544::banks>;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Render a trace segment as one column of bank bytes.
+    /// @param previous previous sample, to join the trace
+    /// @param sample   sample
+    /// @return column bytes, top bank first
+    ////////////////////////////////////////////////////////////////////////////
+    Column render(int previous, int sample) const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Get a sample by age.
+    /// @param age 0 for the newest sample
+    /// @return sample
+    ////////////////////////////////////////////////////////////////////////////
+    int sample(int age) const noexcept;
+
+    PCD8544& m_lcd;
+
+    int m_x{0};
+    int m_bank{0};
+    int m_width{0};
+    int m_bank_count{0};
+    Mode m_mode{Mode::scroll};
+
+    std::array<std::uint8_t, PCD8544::screen_width> m_samples{};
+    int m_head{0};
+    int m_count{0};
+    int m_cursor{0};
+};
+
+
+#endif   // STRIP_CHART_HPP
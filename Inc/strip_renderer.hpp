@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STRIP_RENDERER_HPP
+#define STRIP_RENDERER_HPP
+
+#include "compositor.hpp"
+#include "font.hpp"
+#include "pcd8544.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief One drawing operation of a display list. Coordinates are in pixels
+///        and may be partly off screen. Build items with display_text,
+///        display_rect and display_bitmap.
+////////////////////////////////////////////////////////////////////////////////
+struct DisplayItem
+{
+    enum class Kind
+    {
+        text,
+        rect,
+        bitmap
+    };
+
+    Kind kind{Kind::rect};
+    int x{0};
+    int y{0};
+    int width{0};
+    int height{0};
+    RasterOp op{RasterOp::bit_or};
+
+    std::string_view text{};
+    const Font* font{nullptr};
+    std::span<const std::uint8_t> bitmap{};
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Make a text run item. Glyphs are clipped at the screen edges and
+///        control codes are not processed.
+/// @param x    left edge in pixels
+/// @param y    top edge in pixels
+/// @param s    string, which must outlive the display list
+/// @param font font
+/// @param op   raster operation
+/// @return display item
+////////////////////////////////////////////////////////////////////////////////
+constexpr DisplayItem display_text(const int x, const int y,
+    const std::string_view s, const Font& font,
+    const RasterOp op = RasterOp::bit_or) noexcept
+{
+    return {DisplayItem::Kind::text, x, y, 0,
+        font.banks * PCD8544::pixels_per_bank, op, s, &font, {}};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Make a filled rectangle item. Use bit_or to set, mask to clear and
+///        bit_xor to invert the pixels it covers.
+/// @param x      left edge in pixels
+/// @param y      top edge in pixels
+/// @param width  width in pixels
+/// @param height height in pixels
+/// @param op     raster operation
+/// @return display item
+////////////////////////////////////////////////////////////////////////////////
+constexpr DisplayItem display_rect(const int x, const int y, const int width,
+    const int height, const RasterOp op = RasterOp::bit_or) noexcept
+{
+    return {DisplayItem::Kind::rect, x, y, width, height, op, {}, nullptr, {}};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Make a bitmap item from a bank-major image.
+/// @param x      left edge in pixels
+/// @param y      top edge in pixels
+/// @param width  width in pixels
+/// @param height height in pixels
+/// @param bmp    image, width bytes per bank
+/// @param op     raster operation
+/// @return display item
+////////////////////////////////////////////////////////////////////////////////
+constexpr DisplayItem display_bitmap(const int x, const int y, const int width,
+    const int height, const std::span<const std::uint8_t> bmp,
+    const RasterOp op = RasterOp::bit_or) noexcept
+{
+    return {
+        DisplayItem::Kind::bitmap, x, y, width, height, op, {}, nullptr, bmp};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Draws a display list without a frame buffer. Each bank is
+///        rasterized from the whole list into an 84 byte strip on the stack
+///        and sent straight away, so a frame needs one strip of RAM instead
+///        of 504 bytes.
+////////////////////////////////////////////////////////////////////////////////
+class StripRenderer
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    /// @param lcd display
+    ////////////////////////////////////////////////////////////////////////////
+    explicit StripRenderer(PCD8544& lcd) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw a frame. The screen starts blank and items are drawn in
+    ///        list order.
+    /// @param items display list
+    ////////////////////////////////////////////////////////////////////////////
+    void render(std::span<const DisplayItem> items) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw part of a frame, e.g. to refresh a status line.
+    /// @param items      display list
+    /// @param bank       top bank [0-5]
+    /// @param bank_count number of banks
+    ////////////////////////////////////////////////////////////////////////////
+    void render(std::span<const DisplayItem> items, int bank,
+        int bank_count) noexcept;
+
+  private:
+    PCD8544& m_lcd;
+};
+
+
+#endif   // STRIP_RENDERER_HPP
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTF8_HPP
+#define UTF8_HPP
+
+#include <cstdint>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Table-driven UTF-8 decoder. Every byte costs two table lookups
+///        whatever its class, based on the DFA by Bjoern Hoehrmann.
+////////////////////////////////////////////////////////////////////////////////
+class Utf8Decoder
+{
+  public:
+    static constexpr std::uint8_t accept{0};
+    static constexpr std::uint8_t reject{12};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Feed one byte to the decoder.
+    /// @param byte next byte of the input
+    /// @return accept when a code point is complete, reject on malformed
+    ///         input, anything else while a sequence is incomplete
+    ////////////////////////////////////////////////////////////////////////////
+    std::uint8_t decode(std::uint8_t byte) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Last decoded code point, valid after decode returns accept.
+    /// @return code point
+    ////////////////////////////////////////////////////////////////////////////
+    char32_t code_point() const noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Discard a partial sequence, e.g. after reject.
+    ////////////////////////////////////////////////////////////////////////////
+    void reset() noexcept;
+
+  private:
+    std::uint8_t m_state{accept};
+    char32_t m_code_point{0};
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Map a Unicode code point to the CP437 glyph of the built-in font.
+/// @param code_point code point
+/// @return glyph, or '?' if CP437 has no such character
+////////////////////////////////////////////////////////////////////////////////
+unsigned char to_cp437(char32_t code_point) noexcept;
+
+
+#endif   // UTF8_HPP
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef VIEWPORT_HPP
+#define VIEWPORT_HPP
+
+#include "pcd8544.hpp"
+
+#include <array>
+#include <string_view>
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Text panel clipped to a rectangle of the screen, with its own
+///        cursor, wrapping and scrolling. Viewports share a display and only
+///        ever send bytes inside their own bounds. Uses the display font,
+///        which must be fixed width and one bank high. Drawing moves the
+///        display's text cursor, so set it again before printing to the
+///        display directly.
+////////////////////////////////////////////////////////////////////////////////
+class Viewport
+{
+  public:
+    static constexpr int max_columns{PCD8544::columns};
+    static constexpr int max_rows{PCD8544::banks};
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Constructor.
+    /// @param lcd        display
+    /// @param x          left column [0-83]
+    /// @param bank       top bank [0-5]
+    /// @param width      width in pixels
+    /// @param bank_count height in banks
+    ////////////////////////////////////////////////////////////////////////////
+    Viewport(PCD8544& lcd, int x, int bank, int width, int bank_count) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Wrap text at the right edge. Otherwise characters past the edge
+    ///        are dropped until the next line. On by default.
+    /// @param wrap true to wrap
+    ////////////////////////////////////////////////////////////////////////////
+    void set_wrap(bool wrap) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Scroll text up when a line is added past the bottom row.
+    ///        Otherwise the cursor returns to the top row. On by default.
+    /// @param scroll true to scroll
+    ////////////////////////////////////////////////////////////////////////////
+    void set_scroll(bool scroll) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Set the cursor position within the viewport. Positions outside
+    ///        it wrap around, so -1 is the last column or row.
+    /// @param column horizontal coordinate in characters
+    /// @param row    vertical coordinate in characters
+    ////////////////////////////////////////////////////////////////////////////
+    void set_cursor(int column, int row) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Print a character. Processes NL, FF, and CR.
+    /// @param c character
+    ////////////////////////////////////////////////////////////////////////////
+    void print(char c);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Print a string. Processes NL, FF, and CR.
+    /// @param s string
+    ////////////////////////////////////////////////////////////////////////////
+    void print(std::string_view s);
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Blank the viewport and home the cursor.
+    ////////////////////////////////////////////////////////////////////////////
+    void clear() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw the whole viewport from its text.
+    ////////////////////////////////////////////////////////////////////////////
+    void redraw() noexcept;
+
+  private:
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Draw one character cell.
+    /// @param column horizontal coordinate in characters
+    /// @param row    vertical coordinate in characters
+    ////////////////////////////////////////////////////////////////////////////
+    void draw_cell(int column, int row) noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Move the cursor to the start of the next line, scrolling if
+    ///        needed.
+    ////////////////////////////////////////////////////////////////////////////
+    void new_line() noexcept;
+
+    ////////////////////////////////////////////////////////////////////////////
+    /// @brief Character at a cell.
+    /// @param column horizontal coordinate in characters
+    /// @param row    vertical coordinate in characters
+    /// @return reference to the character
+    ////////////////////////////////////////////////////////////////////////////
+    char& cell(int column, int row) noexcept;
+
+    PCD8544& m_lcd;
+
+    int m_x{0};
+    int m_bank{0};
+    int m_width{0};
+    int m_bank_count{0};
+
+    int m_cell_width{PCD8544::font_width};
+    int m_columns{0};
+
+    int m_column{0};
+    int m_row{0};
+
+    bool m_wrap{true};
+    bool m_scroll{true};
+
+    std::array<char, max_columns * max_rows> m_text{};
+};
+
+
+#endif   // VIEWPORT_HPP
@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "compositor.hpp"
+
+#include "damage.hpp"
+#include "font.hpp"
+#include "pcd8544.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+Layer::Layer(
+    const std::span<std::uint8_t, size> pixels, const RasterOp op) noexcept
+    : m_pixels(pixels.data()), m_writable(pixels.data()), m_op(op)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+Layer::Layer(const std::span<const std::uint8_t, size> pixels,
+    const RasterOp op) noexcept
+    : m_pixels(pixels.data()), m_op(op)
+{
+    m_footprint.add_all();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Layer::set_op(const RasterOp op) noexcept
+{
+    if(op != m_op)
+    {
+        m_op = op;
+        touch_footprint();
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Layer::set_visible(const bool visible) noexcept
+{
+    if(visible != m_visible)
+    {
+        m_visible = visible;
+        touch_footprint();
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool Layer::visible() const noexcept
+{
+    return m_visible;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Layer::clear() noexcept
+{
+    if(m_writable == nullptr)
+        return;
+
+    touch_footprint();
+    m_footprint.clear();
+
+    std::fill_n(m_writable, size, std::uint8_t{0});
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Layer::set_pixels(
+    const int x, const int bank, const std::uint8_t pixels) noexcept
+{
+    if((m_writable == nullptr) || (x < 0) || (x >= PCD8544::screen_width) ||
+        (bank < 0) || (bank >= PCD8544::banks))
+        return;
+
+    m_writable[(bank * PCD8544::screen_width) + x] = pixels;
+    touch(x, bank, 1, 1);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Layer::draw_bitmap(const int x, const int bank, const int width,
+    const int bank_count, const std::span<const std::uint8_t> bmp,
+    const int stride) noexcept
+{
+    if((m_writable == nullptr) || (x < 0) || (x >= PCD8544::screen_width) ||
+        (bank < 0) || (bank >= PCD8544::banks) || (width <= 0) ||
+        (bank_count <= 0) || ((stride != 0) && (stride < width)))
+        return;
+
+    const int size_needed{((bank_count - 1) * stride) + width};
+    if(bmp.size() < static_cast<std::size_t>(size_needed))
+        return;
+
+    const int visible{std::min(width, PCD8544::screen_width - x)};
+    const int rows_visible{std::min(bank_count, PCD8544::banks - bank)};
+
+    for(int row{}; row != rows_visible; ++row)
+    {
+        const auto src = bmp.subspan(static_cast<std::size_t>(row * stride),
+            static_cast<std::size_t>(visible));
+        std::copy(src.begin(), src.end(),
+            m_writable + ((bank + row) * PCD8544::screen_width) + x);
+    }
+
+    touch(x, bank, visible, rows_visible);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+int Layer::draw_text(int x, const int bank, const std::string_view s,
+    const Font& font) noexcept
+{
+    // blank columns for glyph spacing
+    static constexpr std::array<std::uint8_t, PCD8544::banks> blank{};
+
+    for(const auto c : s)
+    {
+        if(x >= PCD8544::screen_width)
+            break;
+
+        const auto uc = static_cast<unsigned char>(c);
+        const int width{font.glyph_width(uc)};
+
+        draw_bitmap(x, bank, width, font.banks, font.glyph(uc), width);
+        for(int col{}; col != font.spacing; ++col)
+            draw_bitmap(x + width + col, bank, 1, font.banks, blank, 0);
+
+        x += width + font.spacing;
+    }
+
+    return x;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+Compositor::Compositor(PCD8544& lcd, const std::span<Layer> layers) noexcept
+    : m_lcd(lcd), m_layers(layers)
+{
+    for(auto& layer : m_layers)
+        layer.m_damage = &m_damage;
+
+    m_damage.add_all();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+Compositor::~Compositor()
+{
+    for(auto& layer : m_layers)
+        layer.m_damage = nullptr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Compositor::invalidate() noexcept
+{
+    m_damage.add_all();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Compositor::flush() noexcept
+{
+    std::array<std::uint8_t, PCD8544::screen_width> row{};
+
+    for(int bank{}; bank != PCD8544::banks; ++bank)
+    {
+        const int begin{m_damage.begin(bank)};
+        const int end{m_damage.end(bank)};
+
+        if(begin == end)
+            continue;
+
+        const auto count = static_cast<std::size_t>(end - begin);
+        std::uint8_t* const dst{row.data() + begin};
+        std::fill_n(dst, count, std::uint8_t{0});
+
+        // one pass per layer, so the raster operation is chosen once per range
+        for(const auto& layer : m_layers)
+        {
+            if(!layer.m_visible)
+                continue;
+
+            const std::uint8_t* const src{
+                layer.m_pixels + (bank * PCD8544::screen_width) + begin};
+
+            // clang-format off
+            switch(layer.m_op)
+            {
+            case RasterOp::bit_or:
+                for(std::size_t n{}; n != count; ++n) dst[n] |= src[n];
+                break;
+            case RasterOp::bit_and:
+                for(std::size_t n{}; n != count; ++n) dst[n] &= src[n];
+                break;
+            case RasterOp::bit_xor:
+                for(std::size_t n{}; n != count; ++n) dst[n] ^= src[n];
+                break;
+            case RasterOp::mask:
+                for(std::size_t n{}; n != count; ++n) dst[n] &= ~src[n];
+                break;
+            }
+            // clang-format on
+        }
+
+        m_lcd.draw_bitmap(begin, bank, end - begin, 1,
+            std::span{row}.subspan(static_cast<std::size_t>(begin)),
+            PCD8544::screen_width);
+    }
+
+    m_damage.clear();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+const Damage& Compositor::damage() const noexcept
+{
+    return m_damage;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+void Layer::touch(
+    const int x, const int bank, const int width, const int bank_count) noexcept
+{
+    m_footprint.add(x, bank, width, bank_count);
+
+    if(m_damage != nullptr)
+        m_damage->add(x, bank, width, bank_count);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Layer::touch_footprint() noexcept
+{
+    if(m_damage != nullptr)
+        m_damage->add(m_footprint);
+}
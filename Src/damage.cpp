@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "damage.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+void Damage::add(
+    const int x, const int bank, const int width, const int bank_count) noexcept
+{
+    const int left{std::max(x, 0)};
+    const int right{std::min(x + width, screen_width)};
+    const int top{std::max(bank, 0)};
+    const int bottom{std::min(bank + bank_count, banks)};
+
+    if((left >= right) || (top >= bottom))
+        return;
+
+    for(int b{top}; b != bottom; ++b)
+    {
+        const auto n = static_cast<std::size_t>(b);
+
+        if(m_begin[n] >= m_end[n])
+        {
+            m_begin[n] = left;
+            m_end[n]   = right;
+        }
+        else
+        {
+            m_begin[n] = std::min(m_begin[n], left);
+            m_end[n]   = std::max(m_end[n], right);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Damage::add(const Damage& other) noexcept
+{
+    for(int b{}; b != banks; ++b)
+        add(other.begin(b), b, other.end(b) - other.begin(b), 1);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Damage::add_all() noexcept
+{
+    m_begin.fill(0);
+    m_end.fill(screen_width);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Damage::clear() noexcept
+{
+    m_begin.fill(0);
+    m_end.fill(0);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool Damage::empty() const noexcept
+{
+    for(std::size_t n{}; n != m_begin.size(); ++n)
+        if(m_begin[n] < m_end[n])
+            return false;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+int Damage::begin(const int bank) const noexcept
+{
+    return m_begin[static_cast<std::size_t>(bank)];
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+int Damage::end(const int bank) const noexcept
+{
+    const auto n = static_cast<std::size_t>(bank);
+    return std::max(m_begin[n], m_end[n]);
+}
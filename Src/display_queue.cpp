@@ -0,0 +1,172 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "display_queue.hpp"
+
+#include "pcd8544.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+DisplayQueue::DisplayQueue(PCD8544& lcd) noexcept : m_lcd(lcd)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool DisplayQueue::clear() noexcept
+{
+    return push({});
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool DisplayQueue::print(
+    const int column, const int row, const std::string_view s) noexcept
+{
+    return push(text(Command::Op::print, column, row, s));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool DisplayQueue::draw_text(
+    const int x, const int bank, const std::string_view s) noexcept
+{
+    return push(text(Command::Op::draw_text, x, bank, s));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool DisplayQueue::draw_bitmap(const int x, const int bank, const int width,
+    const int bank_count, const std::span<const std::uint8_t> bmp,
+    const int stride) noexcept
+{
+    Command command{};
+    command.op         = Command::Op::draw_bitmap;
+    command.x          = x;
+    command.y          = bank;
+    command.width      = width;
+    command.bank_count = bank_count;
+    command.stride     = stride;
+    command.bitmap     = bmp;
+
+    return push(command);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool DisplayQueue::set_contrast(const int level) noexcept
+{
+    Command command{};
+    command.op = Command::Op::set_contrast;
+    command.x  = level;
+
+    return push(command);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+int DisplayQueue::process() noexcept
+{
+    int count{0};
+    Command command{};
+
+    // bounded, as producers may refill the queue as fast as it drains
+    while((count != static_cast<int>(capacity)) && m_queue.pop(command))
+    {
+        const std::string_view s{command.text.data(), command.length};
+
+        switch(command.op)
+        {
+        case Command::Op::clear:
+            m_lcd.clear();
+            break;
+
+        case Command::Op::print:
+            m_lcd.set_cursor(command.x, command.y);
+            m_lcd.print(s);
+            break;
+
+        case Command::Op::draw_text:
+            m_lcd.draw_text(command.x, command.y, s, m_lcd.font());
+            break;
+
+        case Command::Op::draw_bitmap:
+            m_lcd.draw_bitmap(command.x, command.y, command.width,
+                command.bank_count, command.bitmap, command.stride);
+            break;
+
+        case Command::Op::set_contrast:
+            m_lcd.set_contrast(command.x);
+            break;
+        }
+
+        ++count;
+    }
+
+    if(count != 0)
+        m_lcd.flush();
+
+    return count;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t DisplayQueue::dropped() const noexcept
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+bool DisplayQueue::push(const Command& command) noexcept
+{
+    if(m_queue.push(command))
+        return true;
+
+    m_dropped.fetch_add(1U, std::memory_order_relaxed);
+    return false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+DisplayQueue::Command DisplayQueue::text(const Command::Op op, const int x,
+    const int y, const std::string_view s) noexcept
+{
+    Command command{};
+    command.op     = op;
+    command.x      = x;
+    command.y      = y;
+    command.length = std::min(s.size(), command.text.size());
+
+    std::copy_n(s.begin(), command.length, command.text.begin());
+
+    return command;
+}
@@ -0,0 +1,185 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "display_task.hpp"
+
+#include <array>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Data
+////////////////////////////////////////////////////////////////////////////////
+
+struct alignas(std::max_align_t) PoolFrame
+{
+    std::array<std::byte, FramePool::frame_size> bytes;
+};
+
+static std::array<PoolFrame, FramePool::frames> pool{};
+static std::array<std::atomic<bool>, FramePool::frames> in_use{};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+void* FramePool::allocate(const std::size_t size) noexcept
+{
+    if(size > frame_size)
+        return nullptr;
+
+    for(std::size_t n{}; n != frames; ++n)
+    {
+        if(!in_use[n].exchange(true))
+            return pool[n].bytes.data();
+    }
+
+    return nullptr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void FramePool::deallocate(void* const frame) noexcept
+{
+    for(std::size_t n{}; n != frames; ++n)
+    {
+        if(frame == pool[n].bytes.data())
+        {
+            in_use[n].store(false);
+            return;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+DisplayTask DisplayTask::promise_type::get_return_object() noexcept
+{
+    return DisplayTask{
+        std::coroutine_handle<promise_type>::from_promise(*this)};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+DisplayTask DisplayTask::promise_type::
+    get_return_object_on_allocation_failure() noexcept
+{
+    return DisplayTask{};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::suspend_never DisplayTask::promise_type::initial_suspend() const noexcept
+{
+    return {};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::suspend_always DisplayTask::promise_type::final_suspend() const noexcept
+{
+    return {};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void DisplayTask::promise_type::return_void() const noexcept
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void DisplayTask::promise_type::unhandled_exception() const noexcept
+{
+    std::terminate();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void* DisplayTask::promise_type::operator new(const std::size_t size) noexcept
+{
+    return FramePool::allocate(size);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void DisplayTask::promise_type::operator delete(void* const frame) noexcept
+{
+    FramePool::deallocate(frame);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+DisplayTask::DisplayTask(DisplayTask&& other) noexcept
+    : m_handle(std::exchange(other.m_handle, {}))
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+DisplayTask& DisplayTask::operator=(DisplayTask&& other) noexcept
+{
+    if(this != &other)
+    {
+        if(m_handle)
+            m_handle.destroy();
+
+        m_handle = std::exchange(other.m_handle, {});
+    }
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+DisplayTask::~DisplayTask()
+{
+    if(m_handle)
+        m_handle.destroy();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool DisplayTask::valid() const noexcept
+{
+    return static_cast<bool>(m_handle);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool DisplayTask::done() const noexcept
+{
+    return !m_handle || m_handle.done();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+DisplayTask::DisplayTask(
+    const std::coroutine_handle<promise_type> handle) noexcept
+    : m_handle(handle)
+{
+}
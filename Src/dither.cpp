@@ -0,0 +1,192 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "dither.hpp"
+
+#include "pcd8544.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Data
+////////////////////////////////////////////////////////////////////////////////
+
+// 8x8 Bayer matrix scaled to thresholds, a pixel is set below its threshold
+// clang-format off
+static constexpr std::array<std::array<std::uint8_t, 8>, 8> bayer{{
+    {{  2, 130,  34, 162,  10, 138,  42, 170}},
+    {{194,  66, 226,  98, 202,  74, 234, 106}},
+    {{ 50, 178,  18, 146,  58, 186,  26, 154}},
+    {{242, 114, 210,  82, 250, 122, 218,  90}},
+    {{ 14, 142,  46, 174,   6, 134,  38, 166}},
+    {{206,  78, 238, 110, 198,  70, 230, 102}},
+    {{ 62, 190,  30, 158,  54, 182,  22, 150}},
+    {{254, 126, 222,  94, 246, 118, 214,  86}}
+}};
+// clang-format on
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+Dither::Dither(const std::span<const std::uint8_t> gray, const int width,
+    const int height, const Method method) noexcept
+    : m_width(std::clamp(width, 0, max_width)), m_height(std::max(height, 0)),
+      m_method(method)
+{
+    // rows are width bytes apart even if only the left part is converted
+    if(gray.size() >= static_cast<std::size_t>(width * m_height))
+        m_gray = gray;
+    else
+        m_height = 0;
+
+    if(width > max_width)
+        m_height = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+int Dither::banks() const noexcept
+{
+    return (m_height + PCD8544::pixels_per_bank - 1) / PCD8544::pixels_per_bank;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool Dither::next(const std::span<std::uint8_t> out) noexcept
+{
+    if((m_bank >= banks()) || (out.size() < static_cast<std::size_t>(m_width)))
+        return false;
+
+    if(m_method == Method::ordered)
+        ordered(out);
+    else
+        diffuse(out);
+
+    ++m_bank;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Dither::reset() noexcept
+{
+    m_bank = 0;
+    m_error.fill(0);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Dither::draw(PCD8544& lcd, const int x, int bank) noexcept
+{
+    std::array<std::uint8_t, max_width> strip{};
+
+    while((bank < PCD8544::banks) && next(strip))
+    {
+        lcd.draw_bitmap(x, bank, m_width, 1, strip, m_width);
+        ++bank;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+void Dither::ordered(const std::span<std::uint8_t> out) const noexcept
+{
+    const int top{m_bank * PCD8544::pixels_per_bank};
+    const int rows{std::min(PCD8544::pixels_per_bank, m_height - top)};
+
+    for(int x{}; x != m_width; ++x)
+    {
+        const auto& thresholds = bayer[static_cast<std::size_t>(x & 7)];
+        const auto* pixel =
+            &m_gray[static_cast<std::size_t>((top * m_width) + x)];
+
+        // the sign of gray - threshold is the pixel bit
+        unsigned int bits{0U};
+        for(int r{}; r != rows; ++r)
+        {
+            const int gray{*pixel};
+            const int threshold{thresholds[static_cast<std::size_t>(r)]};
+
+            bits |= (static_cast<unsigned int>(gray - threshold) >> 31U)
+                    << static_cast<unsigned int>(r);
+            pixel += m_width;
+        }
+
+        out[static_cast<std::size_t>(x)] = static_cast<std::uint8_t>(bits);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Dither::diffuse(const std::span<std::uint8_t> out) noexcept
+{
+    constexpr int white{255};
+    constexpr int mid{128};
+
+    const int top{m_bank * PCD8544::pixels_per_bank};
+    const int rows{std::min(PCD8544::pixels_per_bank, m_height - top)};
+
+    std::fill(out.begin(), out.begin() + m_width, std::uint8_t{0U});
+
+    for(int r{}; r != rows; ++r)
+    {
+        const auto* pixel =
+            &m_gray[static_cast<std::size_t>((top + r) * m_width)];
+        const auto bit =
+            static_cast<std::uint8_t>(1U << static_cast<unsigned int>(r));
+
+        // m_error[x + 1] holds the error diffused down to column x; it is
+        // replaced by the error for the next row once column x + 1 is done
+        int right{0};
+        int below{0};
+        int below_right{0};
+
+        for(int x{}; x != m_width; ++x)
+        {
+            const auto n = static_cast<std::size_t>(x + 1);
+            const int value{pixel[x] + m_error[n] + right};
+            const bool set{value < mid};
+
+            if(set)
+                out[static_cast<std::size_t>(x)] |= bit;
+
+            // sixteenths of the error: 7 right, 3 below left, 5 below and 1
+            // below right
+            const int error{value - (set ? 0 : white)};
+
+            m_error[n - 1] =
+                static_cast<std::int16_t>(below + ((error * 3) / 16));
+            below          = below_right + ((error * 5) / 16);
+            below_right    = error / 16;
+            right          = (error * 7) / 16;
+        }
+
+        m_error[static_cast<std::size_t>(m_width)] =
+            static_cast<std::int16_t>(below);
+    }
+}
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "font.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Data
+////////////////////////////////////////////////////////////////////////////////
+
+// nibble with every bit doubled, e.g. 0b1010 -> 0b11001100
+static constexpr auto spread2 = [] {
+    std::array<std::uint8_t, 16> lut{};
+    for(unsigned int n{}; n != lut.size(); ++n)
+        for(unsigned int bit{}; bit != 4U; ++bit)
+            if(n & (1U << bit))
+                lut[n] |= static_cast<std::uint8_t>(0x03U << (2U * bit));
+    return lut;
+}();
+
+// nibble with every bit tripled, e.g. 0b0101 -> 0b000111000111
+static constexpr auto spread3 = [] {
+    std::array<std::uint16_t, 16> lut{};
+    for(unsigned int n{}; n != lut.size(); ++n)
+        for(unsigned int bit{}; bit != 4U; ++bit)
+            if(n & (1U << bit))
+                lut[n] |= static_cast<std::uint16_t>(0x07U << (3U * bit));
+    return lut;
+}();
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Non-Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+void scale_glyph(const std::span<const std::uint8_t> glyph, const int scale,
+    const std::span<std::uint8_t> out) noexcept
+{
+    const auto factor = static_cast<std::size_t>(scale);
+    const std::size_t scaled_width{glyph.size() * factor};
+
+    for(std::size_t col{}; col != glyph.size(); ++col)
+    {
+        const unsigned int pixels{glyph[col]};
+        const unsigned int lo{pixels & 0x0FU};
+        const unsigned int hi{pixels >> 4U};
+
+        std::uint32_t bits{pixels};
+        if(scale == 2)
+            bits = spread2[lo] | (std::uint32_t{spread2[hi]} << 8U);
+        else if(scale == 3)
+            bits = spread3[lo] | (std::uint32_t{spread3[hi]} << 12U);
+
+        for(std::size_t row{}; row != factor; ++row)
+        {
+            const auto scaled = static_cast<std::uint8_t>(bits >> (8U * row));
+            std::fill_n(std::next(out.begin(),
+                            static_cast<std::ptrdiff_t>(
+                                (row * scaled_width) + (col * factor))),
+                factor, scaled);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+std::span<const std::uint8_t> GlyphCache::get(
+    const Font& font, const unsigned char c, const int scale) noexcept
+{
+    const auto glyph = font.glyph(c);
+    const auto size  = glyph.size() * static_cast<std::size_t>(scale * scale);
+
+    ++m_clock;
+
+    auto hit = std::find_if(m_entries.begin(), m_entries.end(),
+        [&](const auto& e) {
+            return (e.bitmap == font.bitmap.data()) && (e.scale == scale) &&
+                   (e.c == c);
+        });
+
+    if(hit == m_entries.end())
+    {
+        hit = std::min_element(m_entries.begin(), m_entries.end(),
+            [](const auto& a, const auto& b) {
+                return a.last_use < b.last_use;
+            });
+
+        hit->bitmap = font.bitmap.data();
+        hit->scale  = scale;
+        hit->c      = c;
+        scale_glyph(glyph, scale, hit->data);
+    }
+
+    hit->last_use = m_clock;
+
+    return std::span{hit->data}.first(size);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void GlyphCache::clear() noexcept
+{
+    m_entries.fill(Entry{});
+    m_clock = 0;
+}
@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "grayscale.hpp"
+
+#include "pcd8544.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Non-Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+void split_planes(std::span<const std::uint8_t,
+                      PCD8544::screen_width * PCD8544::screen_height / 4>
+                      gray,
+    std::span<std::uint8_t, PCD8544::screen_width * PCD8544::banks> msb,
+    std::span<std::uint8_t, PCD8544::screen_width * PCD8544::banks> lsb)
+    noexcept
+{
+    constexpr int row_bytes{PCD8544::screen_width / 4};
+
+    for(int bank{}; bank != PCD8544::banks; ++bank)
+    {
+        for(int x{}; x != PCD8544::screen_width; ++x)
+        {
+            const auto shift = static_cast<unsigned int>(6 - ((x % 4) * 2));
+
+            unsigned int high{0U};
+            unsigned int low{0U};
+            for(int r{}; r != PCD8544::pixels_per_bank; ++r)
+            {
+                const int y{(bank * PCD8544::pixels_per_bank) + r};
+                const unsigned int byte{
+                    gray[static_cast<std::size_t>((y * row_bytes) + (x / 4))]};
+                const unsigned int level{byte >> shift};
+
+                high |= ((level >> 1U) & 1U) << static_cast<unsigned int>(r);
+                low |= (level & 1U) << static_cast<unsigned int>(r);
+            }
+
+            const auto n =
+                static_cast<std::size_t>((bank * PCD8544::screen_width) + x);
+            msb[n] = static_cast<std::uint8_t>(high);
+            lsb[n] = static_cast<std::uint8_t>(low);
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+Grayscale::Grayscale(PCD8544& lcd,
+    const std::span<const std::uint8_t, size> msb,
+    const std::span<const std::uint8_t, size> lsb) noexcept
+    : m_lcd(lcd), m_msb(msb), m_lsb(lsb)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Grayscale::set_image(const std::span<const std::uint8_t, size> msb,
+    const std::span<const std::uint8_t, size> lsb) noexcept
+{
+    m_msb  = msb;
+    m_lsb  = lsb;
+    m_full = true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Grayscale::step() noexcept
+{
+    // an address set costs two bytes, so short gaps are cheaper to resend
+    constexpr int max_gap{2};
+
+    const int previous{m_subframe};
+    m_subframe = (m_subframe + 1) % subframes;
+
+    std::array<std::uint8_t, PCD8544::screen_width> strip{};
+
+    for(int bank{}; bank != PCD8544::banks; ++bank)
+    {
+        const int offset{bank * PCD8544::screen_width};
+
+        int begin{-1};
+        int end{-1};
+
+        const auto send = [&]
+        {
+            if(begin >= 0)
+            {
+                m_lcd.draw_bitmap(begin, bank, end - begin, 1,
+                    std::span{strip}.subspan(static_cast<std::size_t>(begin)),
+                    end - begin);
+                m_bytes_sent += static_cast<std::uint32_t>(end - begin);
+            }
+        };
+
+        for(int x{}; x != PCD8544::screen_width; ++x)
+        {
+            const auto pixels = this->pixels(m_subframe, offset + x);
+            strip[static_cast<std::size_t>(x)] = pixels;
+
+            if(!m_full && (pixels == this->pixels(previous, offset + x)))
+                continue;
+
+            if((begin >= 0) && (x - end > max_gap))
+            {
+                send();
+                begin = -1;
+            }
+
+            if(begin < 0)
+                begin = x;
+
+            end = x + 1;
+        }
+
+        send();
+    }
+
+    m_full = false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t Grayscale::bytes_sent() const noexcept
+{
+    return m_bytes_sent;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint8_t Grayscale::pixels(const int subframe, const int n) const noexcept
+{
+    const auto high = m_msb[static_cast<std::size_t>(n)];
+    const auto low  = m_lsb[static_cast<std::size_t>(n)];
+
+    // clang-format off
+    switch(subframe)
+    {
+    case 0:  return high | low;
+    case 1:  return high;
+    default: return high & low;
+    }
+    // clang-format on
+}
@@ -0,0 +1,248 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "heap_guard.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Data
+////////////////////////////////////////////////////////////////////////////////
+
+static std::atomic<std::uint32_t> allocations{0};
+static std::atomic<std::uint32_t> frees{0};
+static std::atomic<std::uint32_t> sbrk_calls{0};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Functions
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef PCD8544_HEAP_GUARD
+////////////////////////////////////////////////////////////////////////////////
+static void* counted_alloc(const std::size_t size) noexcept
+{
+    allocations.fetch_add(1U, std::memory_order_relaxed);
+
+    // malloc(0) may return nullptr, which operator new must not
+    return std::malloc((size != 0U) ? size : 1U);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void* counted_alloc(
+    const std::size_t size, const std::align_val_t align) noexcept
+{
+    allocations.fetch_add(1U, std::memory_order_relaxed);
+
+    // aligned_alloc wants a non-zero multiple of the alignment
+    const auto alignment = static_cast<std::size_t>(align);
+    const std::size_t rounded{
+        ((std::max(size, std::size_t{1U}) + alignment - 1U) / alignment) *
+        alignment};
+
+    return std::aligned_alloc(alignment, rounded);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void counted_free(void* const p) noexcept
+{
+    if(p == nullptr)
+        return;
+
+    frees.fetch_add(1U, std::memory_order_relaxed);
+    std::free(p);
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+HeapGuard::HeapGuard() noexcept : m_start(heap_stats())
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t HeapGuard::allocations() const noexcept
+{
+    const auto now = heap_stats();
+
+    return (now.allocations - m_start.allocations) +
+           (now.sbrk_calls - m_start.sbrk_calls);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool HeapGuard::clean() const noexcept
+{
+    return allocations() == 0U;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Non-Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+HeapStats heap_stats() noexcept
+{
+    return {allocations.load(std::memory_order_relaxed),
+        frees.load(std::memory_order_relaxed),
+        sbrk_calls.load(std::memory_order_relaxed)};
+}
+
+
+#ifdef PCD8544_HEAP_GUARD
+////////////////////////////////////////////////////////////////////////////////
+extern "C" void heap_guard_sbrk(void)
+{
+    sbrk_calls.fetch_add(1U, std::memory_order_relaxed);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new(const std::size_t size)
+{
+    void* const p{counted_alloc(size)};
+    if(p == nullptr)
+        std::abort();
+
+    return p;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new[](const std::size_t size)
+{
+    return operator new(size);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_alloc(size);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_alloc(size);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new(const std::size_t size, const std::align_val_t align)
+{
+    void* const p{counted_alloc(size, align)};
+    if(p == nullptr)
+        std::abort();
+
+    return p;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new[](const std::size_t size, const std::align_val_t align)
+{
+    return operator new(size, align);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new(const std::size_t size, const std::align_val_t align,
+    const std::nothrow_t&) noexcept
+{
+    return counted_alloc(size, align);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void* operator new[](const std::size_t size, const std::align_val_t align,
+    const std::nothrow_t&) noexcept
+{
+    return counted_alloc(size, align);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete(void* const p) noexcept
+{
+    counted_free(p);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete[](void* const p) noexcept
+{
+    counted_free(p);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete(void* const p, std::size_t) noexcept
+{
+    counted_free(p);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete[](void* const p, std::size_t) noexcept
+{
+    counted_free(p);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete(void* const p, std::align_val_t) noexcept
+{
+    counted_free(p);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete[](void* const p, std::align_val_t) noexcept
+{
+    counted_free(p);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete(void* const p, std::size_t, std::align_val_t) noexcept
+{
+    counted_free(p);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void operator delete[](void* const p, std::size_t, std::align_val_t) noexcept
+{
+    counted_free(p);
+}
+#endif
@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "numeric_field.hpp"
+
+#include "font.hpp"
+#include "pcd8544.hpp"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Data
+////////////////////////////////////////////////////////////////////////////////
+
+static constexpr std::array<long, NumericField::max_precision + 1> scale{
+    1L, 10L, 100L, 1000L, 10000L, 100000L, 1000000L};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+NumericField::NumericField(PCD8544& lcd, const int column, const int row,
+    const int width, const int precision) noexcept
+    : m_lcd(lcd),
+      m_cell_width(std::max(lcd.font().width + lcd.font().spacing, 1)),
+      m_row(row % PCD8544::rows),
+      m_precision(std::clamp(precision, 0, max_precision))
+{
+    const int cells{std::clamp(
+        PCD8544::screen_width / m_cell_width, 1, PCD8544::columns)};
+    const int first{column % cells};
+
+    m_x     = first * m_cell_width;
+    m_width = std::clamp(width, 1, cells - first);
+
+    invalidate();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void NumericField::update(const long value) noexcept
+{
+    show(format(value));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void NumericField::update(const double value) noexcept
+{
+    if(!std::isfinite(value))
+    {
+        show(overflow());
+        return;
+    }
+
+    const double scaled{value * static_cast<double>(scale[m_precision])};
+
+    // beyond this lround is undefined, and long may be as narrow as the field
+    constexpr double limit{static_cast<double>(LONG_MAX / 2)};
+
+    if(std::fabs(scaled) > limit)
+    {
+        show(overflow());
+        return;
+    }
+
+    update(std::lround(scaled));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void NumericField::invalidate() noexcept
+{
+    // NUL never matches a formatted character
+    m_shown.fill('\0');
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+NumericField::Text NumericField::format(const long value) const noexcept
+{
+    Text text{};
+    text.fill(' ');
+
+    const bool negative{value < 0};
+    auto magnitude = negative ? 0UL - static_cast<unsigned long>(value)
+                              : static_cast<unsigned long>(value);
+
+    // at least one digit before the decimal point
+    int digits{m_precision + 1};
+    for(auto m = magnitude / static_cast<unsigned long>(scale[m_precision]);
+        m >= 10UL; m /= 10UL)
+        ++digits;
+
+    const int length{digits + (m_precision ? 1 : 0) + (negative ? 1 : 0)};
+    if(length > m_width)
+        return overflow();
+
+    int n{m_width - 1};
+    for(int d{}; d != digits; ++d)
+    {
+        if(m_precision && (d == m_precision))
+            text[n--] = '.';
+
+        text[n--] = static_cast<char>('0' + (magnitude % 10UL));
+        magnitude /= 10UL;
+    }
+
+    if(negative)
+        text[n] = '-';
+
+    return text;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+NumericField::Text NumericField::overflow() const noexcept
+{
+    Text text{};
+    text.fill(' ');
+    std::fill_n(text.begin(), m_width, '#');
+
+    return text;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void NumericField::show(const Text& text) noexcept
+{
+    // changed cells in a run are contiguous in display RAM, so a run of single
+    // bank glyphs costs one address set
+    for(int n{}; n != m_width; ++n)
+    {
+        if(text[n] != m_shown[n])
+        {
+            draw_cell(n, text[n]);
+            m_shown[n] = text[n];
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void NumericField::draw_cell(const int n, const char c) noexcept
+{
+    const Font& font = m_lcd.font();
+    const auto uc    = static_cast<unsigned char>(c);
+    const auto glyph = font.glyph(uc);
+    const int stride{font.glyph_width(uc)};
+    const int width{std::min(stride, m_cell_width)};
+    const int x{m_x + (n * m_cell_width)};
+
+    if((width == 0) ||
+        (glyph.size() < static_cast<std::size_t>(stride * font.banks)))
+    {
+        m_lcd.fill(x, m_row, m_cell_width, font.banks, 0U);
+        return;
+    }
+
+    m_lcd.draw_bitmap(x, m_row, width, font.banks, glyph, stride);
+
+    // spacing, and the rest of the cell for narrow proportional glyphs
+    if(width < m_cell_width)
+        m_lcd.fill(x + width, m_row, m_cell_width - width, font.banks, 0U);
+}
@@ -17,282 +17,67 @@
 
 #include "pcd8544.hpp"
 
+#include "font.hpp"
+#include "spi_bus.hpp"
+#include "utf8.hpp"
+#ifndef PCD8544_NO_BUILTIN_FONT
+    #include "font_6x8.hpp"
+#endif
 #include "stm32f4xx_ll_gpio.h"
-#include "stm32f4xx_ll_spi.h"
 
 #include <algorithm>
 #include <array>
+#include <coroutine>
 #include <cstdint>
-#include <iterator>
+#include <span>
 #include <string_view>
+#include <utility>
 
 
 ////////////////////////////////////////////////////////////////////////////////
 // Static Data
 ////////////////////////////////////////////////////////////////////////////////
 
-// clang-format off
-////////////////////////////////////////////////////////////////////////////////
-static constexpr std::array<std::uint8_t, 1536> font
-{
-    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
-    0x00u, 0x3eu, 0x45u, 0x51u, 0x45u, 0x3eu,
-    0x00u, 0x3eu, 0x7bu, 0x6fu, 0x7bu, 0x3eu,
-    0x00u, 0x1cu, 0x3eu, 0x7cu, 0x3eu, 0x1cu,
-    0x00u, 0x18u, 0x3cu, 0x7eu, 0x3cu, 0x18u,
-    0x00u, 0x18u, 0x5eu, 0x6eu, 0x5eu, 0x18u,
-    0x00u, 0x18u, 0x5cu, 0x6eu, 0x5cu, 0x18u,
-    0x00u, 0x00u, 0x18u, 0x18u, 0x00u, 0x00u,
-    0xffu, 0xffu, 0xe7u, 0xe7u, 0xffu, 0xffu,
-    0x00u, 0x18u, 0x24u, 0x24u, 0x18u, 0x00u,
-    0xffu, 0xe7u, 0xdbu, 0xdbu, 0xe7u, 0xffu,
-    0x70u, 0x88u, 0x88u, 0x8du, 0x73u, 0x07u,
-    0x00u, 0x0eu, 0x51u, 0xf1u, 0x51u, 0x0eu,
-    0x00u, 0x60u, 0x60u, 0x3fu, 0x02u, 0x04u,
-    0x60u, 0x60u, 0x3fu, 0xc5u, 0xcau, 0x7cu,
-    0x00u, 0x2au, 0x1cu, 0x36u, 0x1cu, 0x2au,
-    0x00u, 0x3eu, 0x3eu, 0x1cu, 0x1cu, 0x08u,
-    0x00u, 0x08u, 0x1cu, 0x1cu, 0x3eu, 0x3eu,
-    0x00u, 0x14u, 0x36u, 0x7fu, 0x36u, 0x14u,
-    0x00u, 0x00u, 0x5fu, 0x00u, 0x5fu, 0x00u,
-    0x00u, 0x06u, 0x09u, 0x7fu, 0x01u, 0x7fu,
-    0x40u, 0x9au, 0xa5u, 0xa5u, 0x59u, 0x02u,
-    0x00u, 0xe0u, 0xe0u, 0xe0u, 0xe0u, 0xe0u,
-    0x00u, 0x94u, 0xb6u, 0xffu, 0xb6u, 0x94u,
-    0x00u, 0x08u, 0x0cu, 0xfeu, 0x0cu, 0x08u,
-    0x00u, 0x10u, 0x30u, 0x7fu, 0x30u, 0x10u,
-    0x08u, 0x08u, 0x08u, 0x3eu, 0x1cu, 0x08u,
-    0x08u, 0x1cu, 0x3eu, 0x08u, 0x08u, 0x08u,
-    0x00u, 0x0fu, 0x08u, 0x08u, 0x08u, 0x08u,
-    0x08u, 0x1cu, 0x08u, 0x08u, 0x1cu, 0x08u,
-    0x00u, 0x60u, 0x78u, 0x7eu, 0x78u, 0x60u,
-    0x00u, 0x06u, 0x1eu, 0x7eu, 0x1eu, 0x06u,
-    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u,
-    0x00u, 0x00u, 0x00u, 0x5fu, 0x00u, 0x00u,
-    0x00u, 0x00u, 0x07u, 0x00u, 0x07u, 0x00u,
-    0x00u, 0x14u, 0x7fu, 0x14u, 0x7fu, 0x14u,
-    0x00u, 0x24u, 0x2au, 0x6bu, 0x2au, 0x12u,
-    0x00u, 0x22u, 0x15u, 0x2au, 0x54u, 0x22u,
-    0x00u, 0x36u, 0x49u, 0x56u, 0x20u, 0x50u,
-    0x00u, 0x00u, 0x0bu, 0x07u, 0x00u, 0x00u,
-    0x00u, 0x00u, 0x3eu, 0x41u, 0x00u, 0x00u,
-    0x00u, 0x00u, 0x00u, 0x41u, 0x3eu, 0x00u,
-    0x00u, 0x08u, 0x2au, 0x1cu, 0x2au, 0x08u,
-    0x00u, 0x08u, 0x08u, 0x3eu, 0x08u, 0x08u,
-    0x00u, 0x00u, 0xa0u, 0x60u, 0x00u, 0x00u,
-    0x00u, 0x08u, 0x08u, 0x08u, 0x08u, 0x08u,
-    0x00u, 0x00u, 0x60u, 0x60u, 0x00u, 0x00u,
-    0x00u, 0x60u, 0x30u, 0x18u, 0x0cu, 0x06u,
-    0x00u, 0x3eu, 0x51u, 0x49u, 0x45u, 0x3eu,
-    0x00u, 0x00u, 0x42u, 0x7fu, 0x40u, 0x00u,
-    0x00u, 0x62u, 0x51u, 0x49u, 0x49u, 0x46u,
-    0x00u, 0x22u, 0x49u, 0x49u, 0x49u, 0x36u,
-    0x00u, 0x18u, 0x14u, 0x52u, 0x7fu, 0x50u,
-    0x00u, 0x27u, 0x45u, 0x45u, 0x45u, 0x39u,
-    0x00u, 0x3cu, 0x4au, 0x49u, 0x49u, 0x30u,
-    0x00u, 0x01u, 0x01u, 0x79u, 0x05u, 0x03u,
-    0x00u, 0x36u, 0x49u, 0x49u, 0x49u, 0x36u,
-    0x00u, 0x06u, 0x49u, 0x49u, 0x29u, 0x1eu,
-    0x00u, 0x00u, 0x6cu, 0x6cu, 0x00u, 0x00u,
-    0x00u, 0x00u, 0xacu, 0x6cu, 0x00u, 0x00u,
-    0x00u, 0x08u, 0x14u, 0x22u, 0x41u, 0x00u,
-    0x00u, 0x14u, 0x14u, 0x14u, 0x14u, 0x14u,
-    0x00u, 0x00u, 0x41u, 0x22u, 0x14u, 0x08u,
-    0x00u, 0x06u, 0x01u, 0x51u, 0x09u, 0x06u,
-    0x00u, 0x3eu, 0x41u, 0x5du, 0x55u, 0x5eu,
-    0x00u, 0x7eu, 0x11u, 0x11u, 0x11u, 0x7eu,
-    0x00u, 0x7fu, 0x49u, 0x49u, 0x49u, 0x36u,
-    0x00u, 0x3eu, 0x41u, 0x41u, 0x41u, 0x22u,
-    0x00u, 0x7fu, 0x41u, 0x41u, 0x22u, 0x1cu,
-    0x00u, 0x7fu, 0x49u, 0x49u, 0x49u, 0x41u,
-    0x00u, 0x7fu, 0x09u, 0x09u, 0x09u, 0x01u,
-    0x00u, 0x3eu, 0x41u, 0x41u, 0x51u, 0x72u,
-    0x00u, 0x7fu, 0x08u, 0x08u, 0x08u, 0x7fu,
-    0x00u, 0x00u, 0x41u, 0x7fu, 0x41u, 0x00u,
-    0x00u, 0x30u, 0x40u, 0x40u, 0x40u, 0x3fu,
-    0x00u, 0x7fu, 0x08u, 0x14u, 0x22u, 0x41u,
-    0x00u, 0x7fu, 0x40u, 0x40u, 0x40u, 0x40u,
-    0x00u, 0x7fu, 0x06u, 0x18u, 0x06u, 0x7fu,
-    0x00u, 0x7fu, 0x06u, 0x08u, 0x30u, 0x7fu,
-    0x00u, 0x3eu, 0x41u, 0x41u, 0x41u, 0x3eu,
-    0x00u, 0x7fu, 0x09u, 0x09u, 0x09u, 0x06u,
-    0x00u, 0x3eu, 0x41u, 0x51u, 0x21u, 0x5eu,
-    0x00u, 0x7fu, 0x09u, 0x09u, 0x19u, 0x66u,
-    0x00u, 0x26u, 0x49u, 0x49u, 0x49u, 0x32u,
-    0x00u, 0x01u, 0x01u, 0x7fu, 0x01u, 0x01u,
-    0x00u, 0x3fu, 0x40u, 0x40u, 0x40u, 0x3fu,
-    0x00u, 0x07u, 0x18u, 0x60u, 0x18u, 0x07u,
-    0x00u, 0x7fu, 0x20u, 0x18u, 0x20u, 0x7fu,
-    0x00u, 0x63u, 0x14u, 0x08u, 0x14u, 0x63u,
-    0x00u, 0x03u, 0x0cu, 0x78u, 0x0cu, 0x03u,
-    0x00u, 0x61u, 0x51u, 0x49u, 0x45u, 0x43u,
-    0x00u, 0x00u, 0x7fu, 0x41u, 0x41u, 0x00u,
-    0x00u, 0x06u, 0x0cu, 0x18u, 0x30u, 0x60u,
-    0x00u, 0x00u, 0x41u, 0x41u, 0x7fu, 0x00u,
-    0x00u, 0x04u, 0x02u, 0x01u, 0x02u, 0x04u,
-    0x80u, 0x80u, 0x80u, 0x80u, 0x80u, 0x80u,
-    0x00u, 0x00u, 0x00u, 0x01u, 0x02u, 0x00u,
-    0x00u, 0x20u, 0x54u, 0x54u, 0x54u, 0x78u,
-    0x00u, 0x7fu, 0x28u, 0x44u, 0x44u, 0x38u,
-    0x00u, 0x38u, 0x44u, 0x44u, 0x44u, 0x28u,
-    0x00u, 0x38u, 0x44u, 0x44u, 0x28u, 0x7fu,
-    0x00u, 0x38u, 0x54u, 0x54u, 0x54u, 0x18u,
-    0x00u, 0x08u, 0x7eu, 0x09u, 0x01u, 0x02u,
-    0x00u, 0x18u, 0xa4u, 0xa4u, 0xa8u, 0x7cu,
-    0x00u, 0x7fu, 0x08u, 0x04u, 0x04u, 0x78u,
-    0x00u, 0x00u, 0x44u, 0x7du, 0x40u, 0x00u,
-    0x00u, 0x40u, 0x80u, 0x84u, 0x7du, 0x00u,
-    0x00u, 0x7fu, 0x10u, 0x28u, 0x44u, 0x00u,
-    0x00u, 0x00u, 0x41u, 0x7fu, 0x40u, 0x00u,
-    0x00u, 0x7cu, 0x04u, 0x78u, 0x04u, 0x78u,
-    0x00u, 0x7cu, 0x08u, 0x04u, 0x04u, 0x78u,
-    0x00u, 0x38u, 0x44u, 0x44u, 0x44u, 0x38u,
-    0x00u, 0xfcu, 0x28u, 0x44u, 0x44u, 0x38u,
-    0x00u, 0x38u, 0x44u, 0x44u, 0x28u, 0xfcu,
-    0x00u, 0x44u, 0x78u, 0x44u, 0x04u, 0x08u,
-    0x00u, 0x48u, 0x54u, 0x54u, 0x54u, 0x24u,
-    0x00u, 0x04u, 0x3fu, 0x44u, 0x40u, 0x20u,
-    0x00u, 0x3cu, 0x40u, 0x40u, 0x20u, 0x7cu,
-    0x00u, 0x1cu, 0x20u, 0x40u, 0x20u, 0x1cu,
-    0x00u, 0x3cu, 0x40u, 0x30u, 0x40u, 0x3cu,
-    0x00u, 0x44u, 0x28u, 0x10u, 0x28u, 0x44u,
-    0x00u, 0x1cu, 0xa0u, 0xa0u, 0xa0u, 0x7cu,
-    0x00u, 0x44u, 0x64u, 0x54u, 0x4cu, 0x44u,
-    0x00u, 0x08u, 0x36u, 0x41u, 0x41u, 0x00u,
-    0x00u, 0x00u, 0x00u, 0x7fu, 0x00u, 0x00u,
-    0x00u, 0x00u, 0x41u, 0x41u, 0x36u, 0x08u,
-    0x00u, 0x02u, 0x01u, 0x02u, 0x04u, 0x02u,
-    0x00u, 0x78u, 0x44u, 0x42u, 0x44u, 0x78u,
-    0x00u, 0xbeu, 0xc1u, 0xc1u, 0x41u, 0x22u,
-    0x00u, 0x3cu, 0x41u, 0x40u, 0x21u, 0x7cu,
-    0x00u, 0x38u, 0x54u, 0x56u, 0x55u, 0x18u,
-    0x00u, 0x20u, 0x56u, 0x55u, 0x56u, 0x78u,
-    0x00u, 0x20u, 0x55u, 0x54u, 0x55u, 0x78u,
-    0x00u, 0x20u, 0x55u, 0x56u, 0x54u, 0x78u,
-    0x00u, 0x20u, 0x54u, 0x55u, 0x54u, 0x78u,
-    0x00u, 0xb8u, 0xc4u, 0xc4u, 0x44u, 0x28u,
-    0x00u, 0x38u, 0x56u, 0x55u, 0x56u, 0x18u,
-    0x00u, 0x38u, 0x55u, 0x54u, 0x55u, 0x18u,
-    0x00u, 0x38u, 0x55u, 0x56u, 0x54u, 0x18u,
-    0x00u, 0x00u, 0x45u, 0x7cu, 0x41u, 0x00u,
-    0x00u, 0x00u, 0x46u, 0x7du, 0x42u, 0x00u,
-    0x00u, 0x00u, 0x45u, 0x7eu, 0x40u, 0x00u,
-    0x00u, 0x7cu, 0x13u, 0x12u, 0x13u, 0x7cu,
-    0x00u, 0x7cu, 0x12u, 0x13u, 0x12u, 0x7cu,
-    0x00u, 0x7eu, 0x4au, 0x4bu, 0x4bu, 0x43u,
-    0x00u, 0x74u, 0x54u, 0x78u, 0x54u, 0x5cu,
-    0x00u, 0x7eu, 0x09u, 0x7eu, 0x49u, 0x49u,
-    0x00u, 0x38u, 0x46u, 0x45u, 0x46u, 0x38u,
-    0x00u, 0x38u, 0x45u, 0x44u, 0x45u, 0x38u,
-    0x00u, 0x38u, 0x45u, 0x46u, 0x44u, 0x38u,
-    0x00u, 0x3cu, 0x42u, 0x41u, 0x22u, 0x7cu,
-    0x00u, 0x3cu, 0x41u, 0x42u, 0x20u, 0x7cu,
-    0x00u, 0x1cu, 0xa1u, 0xa0u, 0xa1u, 0x7cu,
-    0x00u, 0x3cu, 0x43u, 0x42u, 0x43u, 0x3cu,
-    0x00u, 0x3eu, 0x41u, 0x40u, 0x41u, 0x3eu,
-    0x00u, 0x38u, 0x44u, 0xc6u, 0x44u, 0x28u,
-    0x00u, 0x48u, 0x7eu, 0x49u, 0x49u, 0x42u,
-    0x00u, 0x29u, 0x2au, 0xfcu, 0x2au, 0x29u,
-    0x00u, 0x7fu, 0x09u, 0x29u, 0xf6u, 0xa0u,
-    0x00u, 0x40u, 0x88u, 0x7eu, 0x09u, 0x02u,
-    0x00u, 0x20u, 0x54u, 0x56u, 0x55u, 0x78u,
-    0x00u, 0x00u, 0x44u, 0x7eu, 0x41u, 0x00u,
-    0x00u, 0x38u, 0x44u, 0x46u, 0x45u, 0x38u,
-    0x00u, 0x3cu, 0x40u, 0x42u, 0x21u, 0x7cu,
-    0x00u, 0x7cu, 0x09u, 0x05u, 0x05u, 0x78u,
-    0x00u, 0x7eu, 0x0du, 0x19u, 0x31u, 0x7eu,
-    0x00u, 0x26u, 0x29u, 0x29u, 0x27u, 0x28u,
-    0x00u, 0x26u, 0x29u, 0x29u, 0x26u, 0x00u,
-    0x00u, 0x30u, 0x48u, 0x45u, 0x40u, 0x30u,
-    0x00u, 0x78u, 0x08u, 0x08u, 0x08u, 0x08u,
-    0x08u, 0x08u, 0x08u, 0x08u, 0x78u, 0x00u,
-    0x00u, 0x17u, 0x08u, 0x04u, 0x6au, 0x58u,
-    0x00u, 0x17u, 0x08u, 0x34u, 0x22u, 0x70u,
-    0x00u, 0x00u, 0x00u, 0x7du, 0x00u, 0x00u,
-    0x08u, 0x14u, 0x22u, 0x08u, 0x14u, 0x22u,
-    0x22u, 0x14u, 0x08u, 0x22u, 0x14u, 0x08u,
-    0x11u, 0x44u, 0x11u, 0x44u, 0x11u, 0x44u,
-    0x55u, 0xaau, 0x55u, 0xaau, 0x55u, 0xaau,
-    0xeeu, 0xbbu, 0xeeu, 0xbbu, 0xeeu, 0xbbu,
-    0x00u, 0x00u, 0x00u, 0xffu, 0x00u, 0x00u,
-    0x08u, 0x08u, 0x08u, 0xffu, 0x00u, 0x00u,
-    0x14u, 0x14u, 0x14u, 0xffu, 0x00u, 0x00u,
-    0x08u, 0x08u, 0xffu, 0x00u, 0xffu, 0x00u,
-    0x08u, 0x08u, 0xf8u, 0x08u, 0xf8u, 0x00u,
-    0x14u, 0x14u, 0x14u, 0xfcu, 0x00u, 0x00u,
-    0x14u, 0x14u, 0xf7u, 0x00u, 0xffu, 0x00u,
-    0x00u, 0x00u, 0xffu, 0x00u, 0xffu, 0x00u,
-    0x14u, 0x14u, 0xf4u, 0x04u, 0xfcu, 0x00u,
-    0x14u, 0x14u, 0x17u, 0x10u, 0x1fu, 0x00u,
-    0x08u, 0x08u, 0x0fu, 0x08u, 0x0fu, 0x00u,
-    0x14u, 0x14u, 0x14u, 0x1fu, 0x00u, 0x00u,
-    0x08u, 0x08u, 0x08u, 0xf8u, 0x00u, 0x00u,
-    0x00u, 0x00u, 0x00u, 0x0fu, 0x08u, 0x08u,
-    0x08u, 0x08u, 0x08u, 0x0fu, 0x08u, 0x08u,
-    0x08u, 0x08u, 0x08u, 0xf8u, 0x08u, 0x08u,
-    0x00u, 0x00u, 0x00u, 0xffu, 0x08u, 0x08u,
-    0x08u, 0x08u, 0x08u, 0x08u, 0x08u, 0x08u,
-    0x08u, 0x08u, 0x08u, 0xffu, 0x08u, 0x08u,
-    0x00u, 0x00u, 0x00u, 0xffu, 0x14u, 0x14u,
-    0x00u, 0x00u, 0xffu, 0x00u, 0xffu, 0x08u,
-    0x00u, 0x00u, 0x1fu, 0x10u, 0x17u, 0x14u,
-    0x00u, 0x00u, 0xfcu, 0x04u, 0xf4u, 0x14u,
-    0x14u, 0x14u, 0x17u, 0x10u, 0x17u, 0x14u,
-    0x14u, 0x14u, 0xf4u, 0x04u, 0xf4u, 0x14u,
-    0x00u, 0x00u, 0xffu, 0x00u, 0xf7u, 0x14u,
-    0x14u, 0x14u, 0x14u, 0x14u, 0x14u, 0x14u,
-    0x14u, 0x14u, 0xf7u, 0x00u, 0xf7u, 0x14u,
-    0x14u, 0x14u, 0x14u, 0x17u, 0x14u, 0x14u,
-    0x08u, 0x08u, 0x0fu, 0x08u, 0x0fu, 0x08u,
-    0x14u, 0x14u, 0x14u, 0xf4u, 0x14u, 0x14u,
-    0x08u, 0x08u, 0xf8u, 0x08u, 0xf8u, 0x08u,
-    0x00u, 0x00u, 0x0fu, 0x08u, 0x0fu, 0x08u,
-    0x00u, 0x00u, 0x00u, 0x1fu, 0x14u, 0x14u,
-    0x00u, 0x00u, 0x00u, 0xfcu, 0x14u, 0x14u,
-    0x00u, 0x00u, 0xf8u, 0x08u, 0xf8u, 0x08u,
-    0x08u, 0x08u, 0xffu, 0x08u, 0xffu, 0x08u,
-    0x14u, 0x14u, 0x14u, 0xffu, 0x14u, 0x14u,
-    0x08u, 0x08u, 0x08u, 0x0fu, 0x00u, 0x00u,
-    0x00u, 0x00u, 0x00u, 0xf8u, 0x08u, 0x08u,
-    0xffu, 0xffu, 0xffu, 0xffu, 0xffu, 0xffu,
-    0xf0u, 0xf0u, 0xf0u, 0xf0u, 0xf0u, 0xf0u,
-    0xffu, 0xffu, 0xffu, 0x00u, 0x00u, 0x00u,
-    0x00u, 0x00u, 0x00u, 0xffu, 0xffu, 0xffu,
-    0x0fu, 0x0fu, 0x0fu, 0x0fu, 0x0fu, 0x0fu,
-    0x00u, 0x38u, 0x44u, 0x44u, 0x38u, 0x44u,
-    0x40u, 0x7cu, 0x02u, 0x4au, 0x4au, 0x34u,
-    0x00u, 0x7fu, 0x01u, 0x01u, 0x01u, 0x01u,
-    0x04u, 0x7cu, 0x04u, 0x04u, 0x7cu, 0x04u,
-    0x00u, 0x63u, 0x55u, 0x49u, 0x41u, 0x41u,
-    0x00u, 0x38u, 0x44u, 0x44u, 0x4cu, 0x34u,
-    0x00u, 0xfcu, 0x40u, 0x40u, 0x40u, 0x7cu,
-    0x00u, 0x08u, 0x04u, 0x7cu, 0x08u, 0x04u,
-    0x00u, 0x1cu, 0x63u, 0x7fu, 0x63u, 0x1cu,
-    0x00u, 0x3eu, 0x49u, 0x49u, 0x49u, 0x3eu,
-    0x00u, 0x5eu, 0x61u, 0x01u, 0x61u, 0x5eu,
-    0x00u, 0x38u, 0x46u, 0x45u, 0x45u, 0x3au,
-    0x38u, 0x44u, 0x44u, 0x38u, 0x44u, 0x38u,
-    0x00u, 0x38u, 0xc4u, 0x7cu, 0x46u, 0x38u,
-    0x00u, 0x1cu, 0x2au, 0x49u, 0x49u, 0x00u,
-    0x00u, 0x7eu, 0x01u, 0x01u, 0x01u, 0x7eu,
-    0x00u, 0x2au, 0x2au, 0x2au, 0x2au, 0x2au,
-    0x00u, 0x48u, 0x48u, 0x7eu, 0x48u, 0x48u,
-    0x00u, 0x00u, 0xc1u, 0xa2u, 0x94u, 0x88u,
-    0x00u, 0x88u, 0x94u, 0xa2u, 0xc1u, 0x00u,
-    0x00u, 0x00u, 0x00u, 0xfcu, 0x02u, 0x0cu,
-    0x00u, 0x30u, 0x40u, 0x3fu, 0x00u, 0x00u,
-    0x00u, 0x08u, 0x08u, 0x2au, 0x08u, 0x08u,
-    0x00u, 0x24u, 0x12u, 0x24u, 0x48u, 0x24u,
-    0x00u, 0x06u, 0x09u, 0x09u, 0x06u, 0x00u,
-    0x00u, 0x00u, 0x18u, 0x18u, 0x00u, 0x00u,
-    0x00u, 0x00u, 0x08u, 0x00u, 0x00u, 0x00u,
-    0x10u, 0x20u, 0x40u, 0xffu, 0x01u, 0x01u,
-    0x00u, 0x00u, 0x0fu, 0x02u, 0x01u, 0x0eu,
-    0x00u, 0x00u, 0x09u, 0x0du, 0x0au, 0x00u,
-    0x00u, 0x3cu, 0x3cu, 0x3cu, 0x3cu, 0x00u,
-    0x00u, 0x00u, 0x00u, 0x00u, 0x00u, 0x00u
-};
-// clang-format on
+// blank columns for glyph spacing
+static constexpr std::array<std::uint8_t, 16> blank{};
+
+// bit-reversed bytes, for flipping bank columns top to bottom
+static constexpr auto reversed_bits = []
+{
+    std::array<std::uint8_t, 256> table{};
+
+    for(unsigned int n{}; n != table.size(); ++n)
+    {
+        unsigned int bits{0U};
+        for(unsigned int bit{}; bit != 8U; ++bit)
+            bits |= ((n >> bit) & 1U) << (7U - bit);
+
+        table[n] = static_cast<std::uint8_t>(bits);
+    }
+
+    return table;
+}();
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+static constexpr bool before(
+    const std::uint32_t a, const std::uint32_t b) noexcept
+{
+    // correct across wraparound of the millisecond count
+    return static_cast<std::int32_t>(a - b) < 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void enable_cycle_counter() noexcept
+{
+    CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL        = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+}
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -300,43 +85,63 @@ static constexpr std::array<std::uint8_t, 1536> font
 ////////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////
-PCD8544::PCD8544(SPI_TypeDef* spi_port, GPIO_TypeDef* sce_port,
-    unsigned int sce_pin, GPIO_TypeDef* rst_port, unsigned int rst_pin,
-    GPIO_TypeDef* dc_port, unsigned int dc_pin)
-    : m_spi_port(spi_port), m_sce_port(sce_port), m_sce_pin(sce_pin),
-      m_rst_port(rst_port), m_rst_pin(rst_pin), m_dc_port(dc_port),
-      m_dc_pin(dc_pin)
+PCD8544::PCD8544(SpiBus& bus, GPIO_TypeDef* sce_port, unsigned int sce_pin,
+    GPIO_TypeDef* rst_port, unsigned int rst_pin, GPIO_TypeDef* dc_port,
+    unsigned int dc_pin, const Startup startup)
+    : m_bus(bus), m_rst_port(rst_port), m_rst_pin(rst_pin)
 {
-    LL_SPI_Enable(m_spi_port);
+#ifndef PCD8544_NO_BUILTIN_FONT
+    m_font = font_6x8;
+#endif
+
+    enable_cycle_counter();
+    const std::uint32_t start{DWT->CYCCNT};
 
-    LL_GPIO_SetOutputPin(m_sce_port, m_sce_pin);
+    m_device = m_bus.attach({sce_port, sce_pin, dc_port, dc_pin});
 
     LL_GPIO_ResetOutputPin(m_rst_port, m_rst_pin);
     LL_GPIO_SetOutputPin(m_rst_port, m_rst_pin);
 
-    send(WriteType::command, FUNC_SET | EXTEND);
-    send(WriteType::command, SET_VOP | static_cast<std::uint8_t>(m_vop));
-    send(WriteType::command, TEMP_CTRL | TEMP0);
+    const std::uint32_t reset{DWT->CYCCNT};
+    m_startup.reset = reset - start;
 
-    constexpr uint8_t bias{3};   // 1:48
-    send(WriteType::command, SET_BIAS | bias);
+    configure();
 
-    send(WriteType::command, FUNC_SET | BASIC);
-    send(WriteType::command, DISP_CTRL | NORMAL);
+    const std::uint32_t configured{DWT->CYCCNT};
+    m_startup.configure = configured - reset;
 
-    clear();
+    if(startup == Startup::clear)
+    {
+        clear();
+        m_startup.first_write = DWT->CYCCNT - configured;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+PCD8544::PCD8544(SpiBus& bus, GPIO_TypeDef* sce_port, unsigned int sce_pin,
+    GPIO_TypeDef* rst_port, unsigned int rst_pin, GPIO_TypeDef* dc_port,
+    unsigned int dc_pin,
+    const std::array<std::uint8_t, screen_width * banks>& splash)
+    : PCD8544(bus, sce_port, sce_pin, rst_port, rst_pin, dc_port, dc_pin,
+          Startup::deferred)
+{
+    const std::uint32_t start{DWT->CYCCNT};
+
+    // the controller resets to address 0, so this is a single data burst
+    draw_bitmap(splash);
+
+    m_startup.first_write = DWT->CYCCNT - start;
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////
 PCD8544::~PCD8544()
 {
-    LL_SPI_Disable(m_spi_port);
+    m_bus.detach(m_device);
 
-    m_spi_port = nullptr;
-    m_sce_port = nullptr;
+    m_device   = -1;
     m_rst_port = nullptr;
-    m_dc_port  = nullptr;
 }
 
 
@@ -348,19 +153,76 @@ void PCD8544::set_contrast(const int level) noexcept
 
     m_vop = (level > max_vop) ? max_vop : level;
 
-    send(WriteType::command, FUNC_SET | EXTEND);
+    send(WriteType::command, FUNC_SET | m_addressing | EXTEND);
     send(WriteType::command, SET_VOP | static_cast<std::uint8_t>(m_vop));
-    send(WriteType::command, FUNC_SET | BASIC);
+    send(WriteType::command, FUNC_SET | m_addressing | BASIC);
 }
 
 
 ////////////////////////////////////////////////////////////////////////////////
 void PCD8544::clear() noexcept
 {
-    set_ram_addr(0, 0);
+    fill(0, 0, screen_width, banks, 0U);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::fill(const int x, const int bank, const int width,
+    const int bank_count, const std::uint8_t pattern) noexcept
+{
+    if((x < 0) || (x >= screen_width) || (bank < 0) || (bank >= banks) ||
+        (width <= 0) || (bank_count <= 0))
+        return;
+
+    const int visible{std::min(width, screen_width - x)};
+    const int rows_visible{std::min(bank_count, banks - bank)};
+
+    select_addressing(HORIZONTAL);
+
+    if(!m_shadow.empty())
+    {
+        for(int row{bank}; row != bank + rows_visible; ++row)
+        {
+            for(int col{x}; col != x + visible; ++col)
+            {
+                auto& pixels = m_shadow[static_cast<std::size_t>(
+                    (row * screen_width) + col)];
+                if(pixels != pattern)
+                {
+                    pixels = pattern;
+                    m_pending.add(col, row, 1, 1);
+                }
+            }
+        }
+    }
+    else
+    {
+        const bool flip_x{(m_orientation == Orientation::rotate_180) ||
+                          (m_orientation == Orientation::mirror_x)};
+        const bool flip_y{(m_orientation == Orientation::rotate_180) ||
+                          (m_orientation == Orientation::mirror_y)};
 
-    for(int n{}; n != screen_width * rows; ++n)
-        send(WriteType::data, 0U);
+        // a uniform window stays uniform when flipped, so only its position
+        // and the bit order of the pattern change
+        const int phys_x{flip_x ? (screen_width - x - visible) : x};
+        const int phys_bank{flip_y ? (banks - bank - rows_visible) : bank};
+        const std::uint8_t data{flip_y ? reversed_bits[pattern] : pattern};
+
+        // full width rows are contiguous in display RAM
+        if(visible == screen_width)
+            send_repeated(0, phys_bank, data, screen_width * rows_visible);
+        else
+        {
+            for(int row{}; row != rows_visible; ++row)
+                send_repeated(phys_x, phys_bank + row, data, visible);
+        }
+    }
+
+    // leave the address where the controller would after the last row
+    const int addr{((bank + rows_visible - 1) * screen_width) + x + visible};
+
+    m_x_addr = addr % screen_width;
+    m_y_addr = (addr / screen_width) % rows;
 }
 
 
@@ -370,6 +232,11 @@ void PCD8544::set_cursor(const int column, const int row) noexcept
     m_x_addr = (column % columns) * font_width;
     m_y_addr = row % rows;
 
+    // the address is sent with the next frame when drawing is deferred, and
+    // with each run when flipped
+    if(!m_shadow.empty() || (m_orientation != Orientation::normal))
+        return;
+
     send(WriteType::command, SET_X_ADDR | static_cast<std::uint8_t>(m_x_addr));
     send(WriteType::command, SET_Y_ADDR | static_cast<std::uint8_t>(m_y_addr));
 }
@@ -405,17 +272,62 @@ void PCD8544::print(const std::string_view s)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::print_utf8(const std::string_view s)
+{
+    Utf8Decoder decoder;
+    auto state = Utf8Decoder::accept;
+
+    for(const auto c : s)
+    {
+        const auto byte = static_cast<std::uint8_t>(c);
+
+        state = decoder.decode(byte);
+        if(state == Utf8Decoder::reject)
+        {
+            write('?');
+
+            // the offending byte may start the next sequence
+            decoder.reset();
+            state = decoder.decode(byte);
+            if(state == Utf8Decoder::reject)
+            {
+                decoder.reset();
+                state = Utf8Decoder::accept;
+                continue;
+            }
+        }
+
+        if(state == Utf8Decoder::accept)
+        {
+            const auto code_point = decoder.code_point();
+            if(code_point < U'\x80')
+                print(static_cast<char>(code_point));
+            else
+                write(to_cp437(code_point));
+        }
+    }
+
+    // truncated sequence at the end of the string
+    if(state != Utf8Decoder::accept)
+        write('?');
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 void PCD8544::write(const unsigned char c)
 {
-    auto it = std::next(font.begin(), font_width * static_cast<int>(c));
-    std::for_each_n(it, font_width,
-        [&](const auto f) { send(WriteType::data, f); });
+    const auto glyph = m_font.glyph(c);
+    if(glyph.empty())
+        return;
 
-    m_x_addr = (m_x_addr + font_width) % screen_width;
+    select_addressing(HORIZONTAL);
 
-    if(m_x_addr == 0)
-        m_y_addr = (m_y_addr + 1) % rows;
+    emit(glyph.first(static_cast<std::size_t>(m_font.glyph_width(c))));
+
+    const auto spacing = static_cast<std::size_t>(m_font.spacing);
+    if(spacing != 0U)
+        emit(std::span{blank}.first(std::min(spacing, blank.size())));
 }
 
 
@@ -425,6 +337,9 @@ void PCD8544::set_ram_addr(const int x, const int y) noexcept
     m_x_addr = x % screen_width;
     m_y_addr = y % rows;
 
+    if(!m_shadow.empty() || (m_orientation != Orientation::normal))
+        return;
+
     send(WriteType::command, SET_X_ADDR | static_cast<std::uint8_t>(m_x_addr));
     send(WriteType::command, SET_Y_ADDR | static_cast<std::uint8_t>(m_y_addr));
 }
@@ -433,12 +348,7 @@ void PCD8544::set_ram_addr(const int x, const int y) noexcept
 ////////////////////////////////////////////////////////////////////////////////
 void PCD8544::set_pixels(const std::uint8_t pixels) noexcept
 {
-    send(WriteType::data, pixels);
-
-    m_x_addr = (m_x_addr + 1) % screen_width;
-
-    if(m_x_addr == 0)
-        m_y_addr = (m_y_addr + 1) % rows;
+    emit(std::span{&pixels, 1});
 }
 
 
@@ -446,10 +356,494 @@ void PCD8544::set_pixels(const std::uint8_t pixels) noexcept
 void PCD8544::draw_bitmap(
     const std::array<std::uint8_t, screen_width * banks>& bmp) noexcept
 {
-    set_ram_addr(0, 0);
+    draw_bitmap(0, 0, screen_width, banks, bmp, screen_width);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::draw_bitmap(const int x, const int bank, const int width,
+    const int bank_count, const std::span<const std::uint8_t> bmp,
+    const int stride) noexcept
+{
+    if((x < 0) || (x >= screen_width) || (bank < 0) || (bank >= banks) ||
+        (width <= 0) || (bank_count <= 0) ||
+        ((stride != 0) && (stride < width)))
+        return;
+
+    const int size{((bank_count - 1) * stride) + width};
+    if(bmp.size() < static_cast<std::size_t>(size))
+        return;
+
+    const int visible{std::min(width, screen_width - x)};
+    const int rows_visible{std::min(bank_count, banks - bank)};
+
+    select_addressing(HORIZONTAL);
+
+    // full width rows of a packed source are contiguous in display RAM
+    if((visible == screen_width) && (stride == screen_width))
+    {
+        move_to(0, bank);
+        emit(bmp.first(static_cast<std::size_t>(screen_width * rows_visible)));
+        return;
+    }
+
+    for(int row{}; row != rows_visible; ++row)
+    {
+        move_to(x, bank + row);
+        emit(bmp.subspan(static_cast<std::size_t>(row * stride),
+            static_cast<std::size_t>(visible)));
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::draw_columns(const int x, const int bank, const int bank_count,
+    const std::span<const std::uint8_t> data) noexcept
+{
+    if((x < 0) || (x >= screen_width) || (bank < 0) || (bank_count <= 0) ||
+        (bank + bank_count > banks))
+        return;
+
+    const auto height = static_cast<std::size_t>(bank_count);
+    const auto count  = std::min(data.size() / height,
+        static_cast<std::size_t>(screen_width - x));
+
+    select_addressing(VERTICAL);
+
+    // full height columns are contiguous in vertical addressing mode
+    if(bank_count == banks)
+    {
+        move_to(x, 0);
+        emit(data.first(count * height));
+        return;
+    }
+
+    for(std::size_t col{}; col != count; ++col)
+    {
+        move_to(x + static_cast<int>(col), bank);
+        emit(data.subspan(col * height, height));
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+PCD8544::Position PCD8544::draw_text(int x, int bank,
+    const std::string_view s, const Font& font) noexcept
+{
+    const int cursor_x{m_x_addr};
+    const int cursor_y{m_y_addr};
+
+    for(const auto c : s)
+    {
+        const auto uc = static_cast<unsigned char>(c);
+        const int width{font.glyph_width(uc)};
+
+        if((x + width > screen_width) && (x != 0))
+        {
+            x = 0;
+            bank += font.banks;
+        }
+
+        if(bank >= banks)
+            break;
+
+        // single bank glyphs on one line are contiguous in display RAM, so
+        // the address is only sent at the start of each line
+        draw_bitmap(x, bank, width, font.banks, font.glyph(uc), width);
+        draw_spacing(x + width, bank, font.spacing, font.banks);
+
+        x += width + font.spacing;
+    }
+
+    // print carries on where it left off
+    move_to(cursor_x, cursor_y);
+
+    return {x, bank};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+PCD8544::Position PCD8544::draw_text(
+    int x, int bank, const std::string_view s, const int scale) noexcept
+{
+    const int factor{std::clamp(scale, 1, GlyphCache::max_scale)};
+
+    if(factor == 1)
+        return draw_text(x, bank, s, m_font);
+
+    if(m_font.banks != 1)
+        return {x, bank};
+
+    const int spacing{m_font.spacing * factor};
+    std::array<std::uint8_t, GlyphCache::max_glyph_size> buffer{};
+
+    const int cursor_x{m_x_addr};
+    const int cursor_y{m_y_addr};
+
+    for(const auto c : s)
+    {
+        const auto uc     = static_cast<unsigned char>(c);
+        const auto source = m_font.glyph(uc);
+
+        if(source.size() > GlyphCache::max_glyph_width)
+            continue;
+
+        const int width{static_cast<int>(source.size()) * factor};
+
+        if((x + width > screen_width) && (x != 0))
+        {
+            x = 0;
+            bank += factor;
+        }
+
+        if(bank >= banks)
+            break;
+
+        std::span<const std::uint8_t> glyph;
+        if(m_glyph_cache != nullptr)
+        {
+            glyph = m_glyph_cache->get(m_font, uc, factor);
+        }
+        else
+        {
+            scale_glyph(source, factor, buffer);
+            glyph = std::span{buffer}.first(
+                static_cast<std::size_t>(width * factor));
+        }
+
+        draw_bitmap(x, bank, width, factor, glyph, width);
+        draw_spacing(x + width, bank, spacing, factor);
+
+        x += width + spacing;
+    }
+
+    move_to(cursor_x, cursor_y);
+
+    return {x, bank};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::set_font(const Font& font) noexcept
+{
+    m_font = font;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+const Font& PCD8544::font() const noexcept
+{
+    return m_font;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::set_addressing(const Addressing addressing) noexcept
+{
+    select_addressing(
+        (addressing == Addressing::vertical) ? VERTICAL : HORIZONTAL);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::set_glyph_cache(GlyphCache* const cache) noexcept
+{
+    m_glyph_cache = cache;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::set_orientation(const Orientation orientation) noexcept
+{
+    m_orientation = orientation;
+
+    if(!m_shadow.empty())
+        m_pending.add_all();
+    else
+        set_ram_addr(m_x_addr, m_y_addr);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::set_frame_buffer(const std::span<std::uint8_t> shadow) noexcept
+{
+    flush();
+
+    constexpr auto size = static_cast<std::size_t>(screen_width * banks);
+
+    if(shadow.size() < size)
+    {
+        // back in step with the controller for immediate drawing
+        m_shadow = {};
+        set_ram_addr(m_x_addr, m_y_addr);
+        return;
+    }
+
+    m_shadow = shadow.first(size);
+    std::fill(m_shadow.begin(), m_shadow.end(), std::uint8_t{0U});
+
+    m_pending.add_all();
+    m_paced = false;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::set_frame_rate(const int fps) noexcept
+{
+    constexpr int ms_per_second{1000};
+
+    m_frame_period = static_cast<std::uint32_t>(
+        ms_per_second / std::clamp(fps, 1, ms_per_second));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool PCD8544::tick(const std::uint32_t now) noexcept
+{
+    // background transfers report stalls from the bus completion
+    check_stalls();
+
+    if(m_powered_down)
+        m_power_down_time += now - m_last_tick;
+
+    m_last_tick = now;
+
+    // any transfer since the last tick restarts the idle period
+    if(m_active)
+    {
+        m_last_active = now;
+        m_active      = false;
+    }
+    else if((m_idle_timeout != 0U) && !m_powered_down &&
+            m_pending.empty() && !m_bus.busy() &&
+            ((now - m_last_active) >= m_idle_timeout))
+    {
+        power_down();
+    }
+
+    if(m_shadow.empty() || m_pending.empty())
+        return false;
+
+    // a frame is due at the next frame slot, or now if the display has been
+    // idle for longer than a frame period
+    if(!m_armed)
+    {
+        m_due   = (m_paced && before(now, m_next_frame)) ? m_next_frame : now;
+        m_armed = true;
+    }
+
+    if(before(now, m_due))
+        return false;
+
+    const std::uint32_t late{now - m_due};
+    m_deadline_misses += late / m_frame_period;
+
+    flush();
+
+    // keep the frame cadence unless a whole period was missed
+    m_next_frame = ((late < m_frame_period) ? m_due : now) + m_frame_period;
+    m_paced      = true;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::flush() noexcept
+{
+    m_armed = false;
+
+    if(m_shadow.empty() || m_pending.empty())
+        return;
+
+    // waking first lets a display RAM restore join this flush
+    if(m_powered_down)
+        wake();
+
+    // a stall recovery while sending marks the whole screen for the next
+    // flush, so the damage is taken before anything is sent
+    const Damage damage{m_pending};
+    m_pending.clear();
+
+    const auto mode = m_addressing;
+    if(mode != HORIZONTAL)
+        send(WriteType::command, FUNC_SET | HORIZONTAL | BASIC);
+
+    // damaged ranges that run on into the next bank need no address
+    int addr{-1};
+
+    for(int bank{}; bank != banks; ++bank)
+    {
+        const int begin{damage.begin(bank)};
+        const int end{damage.end(bank)};
+
+        if(begin == end)
+            continue;
+
+        const int start{(bank * screen_width) + begin};
+        const auto run = m_shadow.subspan(static_cast<std::size_t>(start),
+            static_cast<std::size_t>(end - begin));
+
+        if(m_orientation != Orientation::normal)
+        {
+            send_oriented(begin, bank, HORIZONTAL, run);
+            continue;
+        }
+
+        const std::array<std::uint8_t, 2> address{
+            static_cast<std::uint8_t>(SET_X_ADDR | begin),
+            static_cast<std::uint8_t>(SET_Y_ADDR | bank)};
+
+        const std::span<const std::uint8_t> command{address};
+
+        m_bus.transfer(
+            m_device, {(start != addr) ? command : command.first(0), run});
+
+        addr = (bank * screen_width) + end;
+    }
+
+    if(mode != HORIZONTAL)
+        send(WriteType::command, FUNC_SET | mode | BASIC);
+
+    check_stalls();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t PCD8544::deadline_misses() const noexcept
+{
+    return m_deadline_misses;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+PCD8544::Transfer PCD8544::flush_async() noexcept
+{
+    if(m_shadow.empty() || m_pending.empty() ||
+        (m_orientation != Orientation::normal))
+    {
+        flush();
+        return Transfer{nullptr};
+    }
+
+    if(m_powered_down)
+        wake();
+
+    m_active = true;
+
+    m_async        = Async{};
+    m_async.damage = m_pending;
+    m_async.mode   = m_addressing;
+    m_pending.clear();
+
+    return Transfer{this};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+PCD8544::Transfer PCD8544::draw_bitmap_async(
+    const std::array<std::uint8_t, screen_width * banks>& bmp) noexcept
+{
+    if(!m_shadow.empty() || (m_orientation != Orientation::normal))
+    {
+        draw_bitmap(bmp);
+        return Transfer{nullptr};
+    }
+
+    if(m_powered_down)
+        wake();
+
+    select_addressing(HORIZONTAL);
+    m_active = true;
+
+    m_async        = Async{};
+    m_async.bitmap = bmp;
+    m_async.mode   = HORIZONTAL;
+
+    // the whole of RAM is written, so the address wraps back to the start
+    m_x_addr = 0;
+    m_y_addr = 0;
+
+    return Transfer{this};
+}
 
-    for(const auto pixels : bmp)
-        send(WriteType::data, pixels);
+
+////////////////////////////////////////////////////////////////////////////////
+bool PCD8544::Transfer::await_ready() const noexcept
+{
+    return m_lcd == nullptr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::Transfer::await_suspend(
+    const std::coroutine_handle<> waiter) const noexcept
+{
+    // the waiter is stored first, as an interrupt may complete the transfer
+    // before this returns
+    m_lcd->m_async.waiter = waiter;
+    m_lcd->continue_async();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::Transfer::await_resume() const noexcept
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::set_idle_timeout(
+    const std::uint32_t timeout, const bool restore_ram) noexcept
+{
+    m_idle_timeout = timeout;
+    m_restore_ram  = restore_ram;
+    m_last_active  = m_last_tick;
+
+    // wake latency is measured with the cycle counter
+    enable_cycle_counter();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool PCD8544::powered_down() const noexcept
+{
+    return m_powered_down;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t PCD8544::wakes() const noexcept
+{
+    return m_wakes;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t PCD8544::wake_cycles() const noexcept
+{
+    return m_wake_cycles;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t PCD8544::power_down_time() const noexcept
+{
+    return m_power_down_time;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+const PCD8544::StartupCycles& PCD8544::startup_cycles() const noexcept
+{
+    return m_startup;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t PCD8544::recoveries() const noexcept
+{
+    return m_recoveries;
 }
 
 
@@ -458,23 +852,374 @@ void PCD8544::draw_bitmap(
 ////////////////////////////////////////////////////////////////////////////////
 
 ////////////////////////////////////////////////////////////////////////////////
-void PCD8544::send(const WriteType type, const std::uint8_t data) const noexcept
+PCD8544::Transfer::Transfer(PCD8544* const lcd) noexcept : m_lcd(lcd)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::send(const WriteType type, const std::uint8_t data) noexcept
+{
+    send(type, std::span{&data, 1});
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::send(
+    const WriteType type, const std::span<const std::uint8_t> data) noexcept
 {
+    if(m_powered_down)
+        wake();
+
+    m_active = true;
+
     if(type == WriteType::command)
-        LL_GPIO_ResetOutputPin(m_dc_port, m_dc_pin);
+        m_bus.transfer(m_device, {data, {}});
+    else
+        m_bus.transfer(m_device, {{}, data});
+
+    check_stalls();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::send_oriented(const int x, const int y, const std::uint8_t mode,
+    const std::span<const std::uint8_t> data) noexcept
+{
+    constexpr int total{screen_width * rows};
+
+    const bool flip_x{(m_orientation == Orientation::rotate_180) ||
+                      (m_orientation == Orientation::mirror_x)};
+    const bool flip_y{(m_orientation == Orientation::rotate_180) ||
+                      (m_orientation == Orientation::mirror_y)};
+
+    // RAM addresses run along the minor axis first: columns in horizontal
+    // addressing mode, banks in vertical addressing mode
+    const bool horizontal{mode == HORIZONTAL};
+    const int minor_size{horizontal ? screen_width : rows};
+    const int major_size{horizontal ? rows : screen_width};
+    const bool flip_minor{horizontal ? flip_x : flip_y};
+    const bool flip_major{horizontal ? flip_y : flip_x};
+
+    int addr{horizontal ? ((y * screen_width) + x) : ((x * rows) + y)};
+    std::size_t offset{0U};
+
+    while(offset != data.size())
+    {
+        const int remaining{static_cast<int>(data.size() - offset)};
+        const int minor{addr % minor_size};
+        const int major{addr / minor_size};
+
+        // flipping both axes reverses the whole of RAM, so a run only breaks
+        // where the logical address wraps
+        int count{0};
+        int start{0};
+        if(flip_minor && flip_major)
+        {
+            count = std::min(remaining, total - addr);
+            start = total - addr - count;
+        }
+        else
+        {
+            count = std::min(remaining, minor_size - minor);
+            start = ((flip_major ? (major_size - 1 - major) : major) *
+                        minor_size) +
+                    (flip_minor ? (minor_size - minor - count) : minor);
+        }
+
+        const int phys_x{horizontal ? (start % screen_width) : (start / rows)};
+        const int phys_y{horizontal ? (start / screen_width) : (start % rows)};
+
+        const std::array<std::uint8_t, 2> address{
+            static_cast<std::uint8_t>(SET_X_ADDR | phys_x),
+            static_cast<std::uint8_t>(SET_Y_ADDR | phys_y)};
+        const auto run = data.subspan(offset, static_cast<std::size_t>(count));
+
+        m_bus.transfer(m_device,
+            {address, run, flip_minor, flip_y ? &reversed_bits : nullptr});
+
+        offset += run.size();
+        addr = (addr + count) % total;
+    }
+
+    check_stalls();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::send_repeated(const int x, const int y, const std::uint8_t data,
+    const int count) noexcept
+{
+    if(m_powered_down)
+        wake();
+
+    m_active = true;
+
+    const std::array<std::uint8_t, 2> address{
+        static_cast<std::uint8_t>(SET_X_ADDR | x),
+        static_cast<std::uint8_t>(SET_Y_ADDR | y)};
+
+    m_bus.transfer(m_device, {address, std::span{&data, 1}, false, nullptr,
+                                 static_cast<std::size_t>(count)});
+
+    check_stalls();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::emit(const std::span<const std::uint8_t> data) noexcept
+{
+    if(!m_shadow.empty())
+        store(data);
+    else if(m_orientation != Orientation::normal)
+        send_oriented(m_x_addr, m_y_addr, m_addressing, data);
     else
-        LL_GPIO_SetOutputPin(m_dc_port, m_dc_pin);
+        send(WriteType::data, data);
 
-    LL_GPIO_ResetOutputPin(m_sce_port, m_sce_pin);
+    // the controller wraps to the next bank in horizontal addressing mode, or
+    // to the next column in vertical addressing mode, and back to the start
+    const int size{static_cast<int>(data.size())};
 
-    LL_SPI_TransmitData8(m_spi_port, data);
-    while(!LL_SPI_IsActiveFlag_TXE(m_spi_port))
+    if(m_addressing == HORIZONTAL)
+    {
+        const int addr{(m_y_addr * screen_width) + m_x_addr + size};
+
+        m_x_addr = addr % screen_width;
+        m_y_addr = (addr / screen_width) % rows;
+    }
+    else
     {
+        const int addr{(m_x_addr * rows) + m_y_addr + size};
+
+        m_x_addr = (addr / rows) % screen_width;
+        m_y_addr = addr % rows;
     }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::store(const std::span<const std::uint8_t> data) noexcept
+{
+    int x{m_x_addr};
+    int y{m_y_addr};
 
-    while(LL_SPI_IsActiveFlag_BSY(m_spi_port))
+    for(const auto d : data)
     {
+        auto& pixels =
+            m_shadow[static_cast<std::size_t>((y * screen_width) + x)];
+
+        // unchanged bytes are not sent, so redrawing the same thing is free
+        if(pixels != d)
+        {
+            pixels = d;
+            m_pending.add(x, y, 1, 1);
+        }
+
+        if(m_addressing == HORIZONTAL)
+        {
+            if(++x == screen_width)
+            {
+                x = 0;
+                y = (y + 1) % rows;
+            }
+        }
+        else
+        {
+            if(++y == rows)
+            {
+                y = 0;
+                x = (x + 1) % screen_width;
+            }
+        }
     }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::select_addressing(const std::uint8_t mode) noexcept
+{
+    if(mode != m_addressing)
+    {
+        m_addressing = mode;
+        send(WriteType::command, FUNC_SET | m_addressing | BASIC);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::move_to(const int x, const int y) noexcept
+{
+    if((x != m_x_addr) || (y != m_y_addr))
+        set_ram_addr(x, y);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::draw_spacing(const int x, const int bank, const int width,
+    const int glyph_banks) noexcept
+{
+    fill(x, bank, width, glyph_banks, 0U);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::check_stalls() noexcept
+{
+    if(m_bus.stalls(m_device) != m_stalls_seen)
+        recover();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::recover() noexcept
+{
+    // a stall during recovery is picked up by the next check
+    m_stalls_seen = m_bus.stalls(m_device);
+    ++m_recoveries;
+
+    // the controller may have latched part of a command, so it is reset and
+    // configured from scratch, which also loses display RAM
+    LL_GPIO_ResetOutputPin(m_rst_port, m_rst_pin);
+    LL_GPIO_SetOutputPin(m_rst_port, m_rst_pin);
+
+    configure();
+    m_powered_down = false;
+
+    if(!m_shadow.empty())
+    {
+        m_pending.add_all();
+        return;
+    }
+
+    // the address is sent with each run when flipped
+    if(m_orientation != Orientation::normal)
+        return;
+
+    const std::array<std::uint8_t, 2> address{
+        static_cast<std::uint8_t>(SET_X_ADDR | m_x_addr),
+        static_cast<std::uint8_t>(SET_Y_ADDR | m_y_addr)};
+
+    m_bus.transfer(m_device, {address, {}});
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::continue_async() noexcept
+{
+    auto& async = m_async;
+
+    // after a stall the rest is dropped; recovery resends the whole frame
+    if(m_bus.stalls(m_device) != m_stalls_seen)
+    {
+        async.bitmap = {};
+        std::exchange(async.waiter, {}).resume();
+        return;
+    }
+
+    if(!async.bitmap.empty())
+    {
+        async.command = {SET_X_ADDR, SET_Y_ADDR};
+
+        const auto bitmap = std::exchange(async.bitmap, {});
+        m_bus.start(m_device,
+            {std::span{async.command}.first(2), bitmap}, on_transfer, this);
+        return;
+    }
+
+    // one transaction per damaged bank, the first one switching to
+    // horizontal addressing if needed
+    for(; async.bank != banks; ++async.bank)
+    {
+        const int bank{async.bank};
+        const int begin{async.damage.begin(bank)};
+        const int end{async.damage.end(bank)};
+
+        if(begin == end)
+            continue;
+
+        std::size_t size{0U};
+        if((async.mode != HORIZONTAL) && !async.restore)
+        {
+            async.command[size++] = FUNC_SET | HORIZONTAL | BASIC;
+            async.restore         = true;
+        }
+
+        async.command[size++] = static_cast<std::uint8_t>(SET_X_ADDR | begin);
+        async.command[size++] = static_cast<std::uint8_t>(SET_Y_ADDR | bank);
+
+        const auto run =
+            m_shadow.subspan(static_cast<std::size_t>((bank * screen_width) +
+                                                      begin),
+                static_cast<std::size_t>(end - begin));
+
+        ++async.bank;
+        m_bus.start(m_device, {std::span{async.command}.first(size), run},
+            on_transfer, this);
+        return;
+    }
+
+    if(async.restore)
+    {
+        async.command[0] = FUNC_SET | async.mode | BASIC;
+        async.restore    = false;
+
+        m_bus.start(m_device, {std::span{async.command}.first(1), {}},
+            on_transfer, this);
+        return;
+    }
+
+    std::exchange(async.waiter, {}).resume();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::on_transfer(void* const lcd) noexcept
+{
+    static_cast<PCD8544*>(lcd)->continue_async();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::configure() noexcept
+{
+    // the power-down bit is clear in both function set commands, so this
+    // also wakes the controller
+    const std::array<std::uint8_t, 6> commands{
+        static_cast<std::uint8_t>(FUNC_SET | ACTIVE | m_addressing | EXTEND),
+        static_cast<std::uint8_t>(SET_VOP | m_vop),
+        static_cast<std::uint8_t>(TEMP_CTRL | TEMP0),
+        static_cast<std::uint8_t>(SET_BIAS | BIAS_1_48),
+        static_cast<std::uint8_t>(FUNC_SET | ACTIVE | m_addressing | BASIC),
+        static_cast<std::uint8_t>(DISP_CTRL | NORMAL)};
+
+    m_bus.transfer(m_device, {commands, {}});
+    m_active = true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::power_down() noexcept
+{
+    const std::array<std::uint8_t, 1> command{
+        static_cast<std::uint8_t>(FUNC_SET | POWERDOWN | m_addressing | BASIC)};
+
+    m_bus.transfer(m_device, {command, {}});
+    m_powered_down = true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void PCD8544::wake() noexcept
+{
+    const std::uint32_t start{DWT->CYCCNT};
+
+    // the extended settings are resent in case the board dropped them
+    configure();
+    m_powered_down = false;
+
+    if(m_restore_ram && !m_shadow.empty())
+        m_pending.add_all();
 
-    LL_GPIO_SetOutputPin(m_sce_port, m_sce_pin);
+    m_wake_cycles = DWT->CYCCNT - start;
+    ++m_wakes;
 }
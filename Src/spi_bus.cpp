@@ -0,0 +1,761 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "spi_bus.hpp"
+
+#include "stm32f4xx_ll_dma.h"
+#include "stm32f4xx_ll_gpio.h"
+#include "stm32f4xx_ll_spi.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Data
+////////////////////////////////////////////////////////////////////////////////
+
+// position of each stream's flags in the interrupt flag clear registers
+static constexpr std::array<std::uint32_t, 4> dma_flag_shift{0U, 6U, 16U, 22U};
+static constexpr std::uint32_t dma_flags{0x3DU};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+static void pulse(
+    volatile std::uint32_t& reg, const std::uint32_t mask) noexcept
+{
+    reg = reg | mask;
+    reg = reg & ~mask;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static std::uint32_t enter_critical() noexcept
+{
+    const std::uint32_t primask{__get_PRIMASK()};
+    __disable_irq();
+
+    return primask;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void exit_critical(const std::uint32_t primask) noexcept
+{
+    __set_PRIMASK(primask);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void reset_peripheral(const SPI_TypeDef* const spi) noexcept
+{
+    // clang-format off
+    if(spi == SPI1)      pulse(RCC->APB2RSTR, RCC_APB2RSTR_SPI1RST);
+    else if(spi == SPI2) pulse(RCC->APB1RSTR, RCC_APB1RSTR_SPI2RST);
+    else if(spi == SPI3) pulse(RCC->APB1RSTR, RCC_APB1RSTR_SPI3RST);
+    else if(spi == SPI4) pulse(RCC->APB2RSTR, RCC_APB2RSTR_SPI4RST);
+    else if(spi == SPI5) pulse(RCC->APB2RSTR, RCC_APB2RSTR_SPI5RST);
+    // clang-format on
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+SpiBus::SpiBus(SPI_TypeDef* spi_port, const Policy policy) noexcept
+    : m_spi_port(spi_port), m_policy(policy)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+SpiBus::~SpiBus()
+{
+    wait_async();
+    drain();
+
+    if(m_users != 0)
+        LL_SPI_Disable(m_spi_port);
+
+    m_spi_port = nullptr;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+int SpiBus::attach(const Device& device) noexcept
+{
+    for(int id{}; id != max_devices; ++id)
+    {
+        auto& slot = m_slots[static_cast<std::size_t>(id)];
+        if(slot.attached)
+            continue;
+
+        slot          = Slot{};
+        slot.device   = device;
+        slot.attached = true;
+
+        LL_GPIO_SetOutputPin(device.sce_port, device.sce_pin);
+
+        if(m_users++ == 0)
+        {
+            // waits are timed with the cycle counter
+            CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+            DWT->CTRL        = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+
+            LL_SPI_Enable(m_spi_port);
+        }
+
+        return id;
+    }
+
+    return -1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::detach(const int id) noexcept
+{
+    if((id < 0) || (id >= max_devices))
+        return;
+
+    auto& slot = m_slots[static_cast<std::size_t>(id)];
+    if(!slot.attached)
+        return;
+
+    drain();
+
+    slot.attached = false;
+
+    if(--m_users == 0)
+        LL_SPI_Disable(m_spi_port);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool SpiBus::submit(const int id, const Transaction& transaction) noexcept
+{
+    if((id < 0) || (id >= max_devices))
+        return false;
+
+    auto& slot = m_slots[static_cast<std::size_t>(id)];
+
+    // completion callbacks may queue transactions from the SPI interrupt
+    const std::uint32_t primask{enter_critical()};
+
+    const bool queued{slot.attached && (slot.count != queue_depth)};
+    if(queued)
+    {
+        const int tail{(slot.head + slot.count) % queue_depth};
+        slot.queue[static_cast<std::size_t>(tail)] = transaction;
+        ++slot.count;
+    }
+
+    exit_critical(primask);
+
+    return queued;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::drain() noexcept
+{
+    // a completion callback runs while the owner, if any, waits for the
+    // transfer that just finished, so it may send without taking the bus
+    if(m_completing)
+    {
+        send_queued(true);
+        return;
+    }
+
+    // one task sends at a time; another finds the bus taken and leaves its
+    // transactions to the owner, which sends until every queue is empty
+    if(m_owned.exchange(true))
+        return;
+
+    send_queued(false);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool SpiBus::transfer(const int id, const Transaction& transaction) noexcept
+{
+    if(!submit(id, transaction))
+    {
+        drain();
+        if(!submit(id, transaction))
+            return false;
+    }
+
+    // the owner may be sending this transaction for us, and the bytes must
+    // stay valid until it is off the wire
+    do
+    {
+        drain();
+    } while((pending(id) != 0) || (m_owned.load() && !m_completing));
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+int SpiBus::pending(const int id) const noexcept
+{
+    if((id < 0) || (id >= max_devices))
+        return 0;
+
+    return m_slots[static_cast<std::size_t>(id)].count;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::set_policy(const Policy policy) noexcept
+{
+    m_policy = policy;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool SpiBus::start(const int id, const Transaction& transaction,
+    const Completion done, void* const context) noexcept
+{
+    if((id < 0) || (id >= max_devices))
+        return false;
+
+    auto& slot = m_slots[static_cast<std::size_t>(id)];
+    if(!slot.attached)
+        return false;
+
+    // a completion callback chains straight on from the transfer that just
+    // finished; queued transactions are left for thread context. Otherwise
+    // the bus is held until this transfer is under way, so no other task
+    // starts sending in between
+    const bool owner{!m_completing};
+    if(owner)
+    {
+        while(m_owned.exchange(true))
+        {
+        }
+
+        send_queued(true);
+    }
+    else
+    {
+        m_chained = true;
+    }
+
+    m_async        = transaction;
+    m_async_slot   = &slot;
+    m_async_index  = 0U;
+    m_async_data   = transaction.command.empty();
+    m_done         = done;
+    m_context      = context;
+
+    if(m_async_data)
+        LL_GPIO_SetOutputPin(slot.device.dc_port, slot.device.dc_pin);
+    else
+        LL_GPIO_ResetOutputPin(slot.device.dc_port, slot.device.dc_pin);
+
+    LL_GPIO_ResetOutputPin(slot.device.sce_port, slot.device.sce_pin);
+
+    m_busy.store(true);
+
+    if(m_interrupt)
+        LL_SPI_EnableIT_TXE(m_spi_port);
+
+    if(owner)
+        m_owned.store(false);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool SpiBus::busy() const noexcept
+{
+    return m_busy.load();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::service() noexcept
+{
+    if(!m_busy.load())
+        return;
+
+    const auto& device = m_async_slot->device;
+
+    while(LL_SPI_IsActiveFlag_TXE(m_spi_port))
+    {
+        if(!m_async_data)
+        {
+            if(m_async_index != m_async.command.size())
+            {
+                LL_SPI_TransmitData8(
+                    m_spi_port, m_async.command[m_async_index++]);
+                continue;
+            }
+
+            // mode select is sampled with the last bit of each byte
+            if(!wait_idle())
+            {
+                abort_async();
+                return;
+            }
+
+            LL_GPIO_SetOutputPin(device.dc_port, device.dc_pin);
+
+            m_async_data  = true;
+            m_async_index = 0U;
+        }
+
+        const auto data = m_async.data;
+        if(m_async_index != data.size() * m_async.repeat)
+        {
+            const auto n = m_async_index % data.size();
+            const auto i = m_async.reversed ? (data.size() - 1U - n) : n;
+
+            auto d = data[i];
+            if(m_async.map != nullptr)
+                d = (*m_async.map)[d];
+
+            LL_SPI_TransmitData8(m_spi_port, d);
+            ++m_async_index;
+            continue;
+        }
+
+        // all bytes are in the shifter, which drains in eight bit times
+        LL_SPI_DisableIT_TXE(m_spi_port);
+        if(!wait_idle())
+        {
+            abort_async();
+            return;
+        }
+
+        LL_GPIO_SetOutputPin(device.sce_port, device.sce_pin);
+
+        complete();
+        return;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::set_interrupt(const bool enabled) noexcept
+{
+    m_interrupt = enabled;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::set_timeout(const std::uint32_t cycles) noexcept
+{
+    m_timeout = cycles;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint32_t SpiBus::stalls(const int id) const noexcept
+{
+    if((id < 0) || (id >= max_devices))
+        return 0U;
+
+    return m_slots[static_cast<std::size_t>(id)].stalls;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+const SpiBus::WaitStats& SpiBus::wait_stats() const noexcept
+{
+    return m_stats;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::reset_wait_stats() noexcept
+{
+    m_stats = WaitStats{};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::set_dma(DMA_TypeDef* const dma, const std::uint32_t stream,
+    const std::uint32_t channel) noexcept
+{
+    wait_async();
+    drain();
+
+    m_dma        = dma;
+    m_dma_stream = stream;
+
+    if(m_dma == nullptr)
+        return;
+
+    // the memory address is not incremented, so every request reads m_fill
+    LL_DMA_DisableStream(m_dma, m_dma_stream);
+    LL_DMA_SetChannelSelection(m_dma, m_dma_stream, channel);
+    LL_DMA_ConfigTransfer(m_dma, m_dma_stream,
+        LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_MODE_NORMAL |
+            LL_DMA_PERIPH_NOINCREMENT | LL_DMA_MEMORY_NOINCREMENT |
+            LL_DMA_PDATAALIGN_BYTE | LL_DMA_MDATAALIGN_BYTE |
+            LL_DMA_PRIORITY_LOW);
+    LL_DMA_SetPeriphAddress(
+        m_dma, m_dma_stream, LL_SPI_DMA_GetRegAddr(m_spi_port));
+    LL_DMA_SetMemoryAddress(m_dma, m_dma_stream,
+        static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&m_fill)));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+int SpiBus::next() const noexcept
+{
+    int chosen{-1};
+
+    // search from the device after the last one served, so ties go round
+    for(int n{1}; n <= max_devices; ++n)
+    {
+        const int id{(m_last + n) % max_devices};
+        const auto& slot = m_slots[static_cast<std::size_t>(id)];
+
+        if(slot.count == 0)
+            continue;
+
+        if(m_policy == Policy::round_robin)
+            return id;
+
+        if((chosen < 0) ||
+            (slot.device.priority <
+                m_slots[static_cast<std::size_t>(chosen)].device.priority))
+            chosen = id;
+    }
+
+    return chosen;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::send_queued(const bool keep) noexcept
+{
+    for(;;)
+    {
+        // queued transactions go out after a background transfer
+        wait_async();
+
+        Slot* slot{nullptr};
+        Transaction transaction{};
+
+        // each transaction is taken off its queue before it is sent, so it
+        // cannot be picked up twice
+        const std::uint32_t primask{enter_critical()};
+
+        const int id{next()};
+        if(id >= 0)
+        {
+            slot        = &m_slots[static_cast<std::size_t>(id)];
+            transaction = slot->queue[static_cast<std::size_t>(slot->head)];
+            slot->head  = (slot->head + 1) % queue_depth;
+            --slot->count;
+            m_last = id;
+        }
+        else if(!keep)
+        {
+            // released with the queues seen empty, so a transaction queued by
+            // a task that found the bus taken is never left behind
+            m_owned.store(false);
+        }
+
+        exit_critical(primask);
+
+        if(slot == nullptr)
+            return;
+
+        run(*slot, transaction);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::run(Slot& slot, const Transaction& transaction) noexcept
+{
+    const auto& device = slot.device;
+
+    LL_GPIO_ResetOutputPin(device.sce_port, device.sce_pin);
+    const bool sent{send(device, transaction)};
+    LL_GPIO_SetOutputPin(device.sce_port, device.sce_pin);
+
+    // the rest of a stalled transaction is dropped
+    if(!sent)
+        stall(slot);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool SpiBus::send(
+    const Device& device, const Transaction& transaction) noexcept
+{
+    if(!transaction.command.empty())
+    {
+        LL_GPIO_ResetOutputPin(device.dc_port, device.dc_pin);
+
+        for(const auto c : transaction.command)
+        {
+            if(!wait_txe())
+                return false;
+
+            LL_SPI_TransmitData8(m_spi_port, c);
+        }
+
+        // mode select is sampled with the last bit of each byte
+        if(!wait_idle())
+            return false;
+    }
+
+    const auto data = transaction.data;
+    if(data.empty())
+        return true;
+
+    LL_GPIO_SetOutputPin(device.dc_port, device.dc_pin);
+
+    if((data.size() == 1U) && (transaction.repeat > 1U) && (m_dma != nullptr))
+    {
+        m_fill = (transaction.map != nullptr) ? (*transaction.map)[data[0]]
+                                              : data[0];
+        if(!send_dma(transaction.repeat))
+            return false;
+    }
+    else if(!transaction.reversed && (transaction.map == nullptr))
+    {
+        // keep the transmit buffer full and only drain at the end
+        for(std::size_t r{}; r != transaction.repeat; ++r)
+        {
+            for(const auto d : data)
+            {
+                if(!wait_txe())
+                    return false;
+
+                LL_SPI_TransmitData8(m_spi_port, d);
+            }
+        }
+    }
+    else
+    {
+        const auto total = data.size() * transaction.repeat;
+
+        for(std::size_t index{}; index != total; ++index)
+        {
+            const auto n = index % data.size();
+            const auto i = transaction.reversed ? (data.size() - 1U - n) : n;
+
+            auto d = data[i];
+            if(transaction.map != nullptr)
+                d = (*transaction.map)[d];
+
+            if(!wait_txe())
+                return false;
+
+            LL_SPI_TransmitData8(m_spi_port, d);
+        }
+    }
+
+    return wait_idle();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool SpiBus::send_dma(std::size_t count) noexcept
+{
+    const auto shift = dma_flag_shift[m_dma_stream % dma_flag_shift.size()];
+
+    LL_SPI_EnableDMAReq_TX(m_spi_port);
+
+    while(count != 0U)
+    {
+        const auto length = std::min(count, max_dma_length);
+
+        // stale flags from the last transfer would stop the stream enabling
+        if(m_dma_stream < dma_flag_shift.size())
+            m_dma->LIFCR = dma_flags << shift;
+        else
+            m_dma->HIFCR = dma_flags << shift;
+
+        LL_DMA_SetDataLength(
+            m_dma, m_dma_stream, static_cast<std::uint32_t>(length));
+        LL_DMA_EnableStream(m_dma, m_dma_stream);
+
+        // the stream disables itself after the last request, and is allowed
+        // the timeout for every byte
+        const std::uint64_t limit{std::uint64_t{m_timeout} * length};
+        const std::uint32_t start{DWT->CYCCNT};
+
+        while(LL_DMA_IsEnabledStream(m_dma, m_dma_stream))
+        {
+            if(DWT->CYCCNT - start > limit)
+            {
+                LL_DMA_DisableStream(m_dma, m_dma_stream);
+                LL_SPI_DisableDMAReq_TX(m_spi_port);
+                return false;
+            }
+        }
+
+        count -= length;
+    }
+
+    LL_SPI_DisableDMAReq_TX(m_spi_port);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool SpiBus::wait_txe() noexcept
+{
+    const std::uint32_t start{DWT->CYCCNT};
+
+    while(!LL_SPI_IsActiveFlag_TXE(m_spi_port))
+    {
+        if(DWT->CYCCNT - start > m_timeout)
+            return false;
+    }
+
+    record(DWT->CYCCNT - start);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+bool SpiBus::wait_idle() noexcept
+{
+    if(!wait_txe())
+        return false;
+
+    const std::uint32_t start{DWT->CYCCNT};
+
+    while(LL_SPI_IsActiveFlag_BSY(m_spi_port))
+    {
+        if(DWT->CYCCNT - start > m_timeout)
+            return false;
+    }
+
+    record(DWT->CYCCNT - start);
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::wait_async() noexcept
+{
+    // a background transfer stalls when no byte goes out within the timeout
+    std::size_t index{m_async_index};
+    bool data{m_async_data};
+    std::uint32_t start{DWT->CYCCNT};
+
+    // inside a completion callback the transfer that finished counts as done
+    while(m_busy.load() && !(m_completing && !m_chained))
+    {
+        if(!m_interrupt)
+            service();
+
+        if((m_async_index != index) || (m_async_data != data))
+        {
+            index = m_async_index;
+            data  = m_async_data;
+            start = DWT->CYCCNT;
+        }
+        else if(m_busy.load() && (DWT->CYCCNT - start > m_timeout))
+        {
+            abort_async();
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::abort_async() noexcept
+{
+    LL_SPI_DisableIT_TXE(m_spi_port);
+    LL_GPIO_SetOutputPin(
+        m_async_slot->device.sce_port, m_async_slot->device.sce_pin);
+
+    stall(*m_async_slot);
+
+    // the waiter is resumed, and finds out from the stall count
+    complete();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::complete() noexcept
+{
+    // the bus stays busy while the callback runs, so nothing else sees it
+    // idle before the callback has chained its next transfer
+    const bool outer_completing{std::exchange(m_completing, true)};
+    const bool outer_chained{std::exchange(m_chained, false)};
+
+    if(m_done != nullptr)
+        m_done(m_context);
+
+    const bool chained{m_chained};
+
+    m_completing = outer_completing;
+    m_chained    = outer_chained;
+
+    if(!chained)
+        m_busy.store(false);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::stall(Slot& slot) noexcept
+{
+    ++slot.stalls;
+    ++m_stats.stalls;
+
+    // resetting the peripheral clears its registers, so the configuration is
+    // put back afterwards
+    const std::uint32_t cr1{m_spi_port->CR1};
+    const std::uint32_t cr2{m_spi_port->CR2};
+
+    reset_peripheral(m_spi_port);
+
+    m_spi_port->CR2 = cr2 & ~(SPI_CR2_TXDMAEN | SPI_CR2_TXEIE);
+    m_spi_port->CR1 = cr1;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpiBus::record(const std::uint32_t cycles) noexcept
+{
+    const auto bucket =
+        std::min(static_cast<std::size_t>(std::bit_width(cycles)),
+            m_stats.histogram.size() - 1U);
+
+    ++m_stats.histogram[bucket];
+    m_stats.worst = std::max(m_stats.worst, cycles);
+}
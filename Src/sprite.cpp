@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "sprite.hpp"
+
+#include "pcd8544.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+static constexpr bool overlaps(const BankRect& a, const BankRect& b) noexcept
+{
+    return (a.x0 < b.x1) && (b.x0 < a.x1) && (a.bank0 < b.bank1) &&
+           (b.bank0 < a.bank1);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static constexpr BankRect unite(const BankRect& a, const BankRect& b) noexcept
+{
+    return {std::min(a.x0, b.x0), std::max(a.x1, b.x1),
+        std::min(a.bank0, b.bank0), std::max(a.bank1, b.bank1)};
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static constexpr int floor_bank(const int y) noexcept
+{
+    return (y >= 0) ? (y / PCD8544::pixels_per_bank)
+                    : -((PCD8544::pixels_per_bank - 1 - y) /
+                        PCD8544::pixels_per_bank);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+Sprite::Sprite(const std::span<const std::uint8_t> image, const int width,
+    const int height, const std::span<const std::uint8_t> mask) noexcept
+    : m_width(std::max(width, 0)),
+      m_height(std::clamp(height, 1, PCD8544::screen_height)),
+      m_banks((m_height + PCD8544::pixels_per_bank - 1) /
+              PCD8544::pixels_per_bank)
+{
+    set_image(image, mask);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Sprite::move_to(const int x, const int y) noexcept
+{
+    if((x != m_x) || (y != m_y))
+    {
+        m_x       = x;
+        m_y       = y;
+        m_changed = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Sprite::set_image(const std::span<const std::uint8_t> image,
+    const std::span<const std::uint8_t> mask) noexcept
+{
+    const auto size = static_cast<std::size_t>(m_width * m_banks);
+
+    m_image   = (image.size() >= size) ? image.first(size) : decltype(image){};
+    m_mask    = (mask.size() >= size) ? mask.first(size) : decltype(mask){};
+    m_changed = true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Sprite::set_visible(const bool visible) noexcept
+{
+    if(visible != m_visible)
+    {
+        m_visible = visible;
+        m_changed = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+BankRect Sprite::bounds() const noexcept
+{
+    BankRect rect{std::max(m_x, 0),
+        std::min(m_x + m_width, PCD8544::screen_width),
+        std::max(floor_bank(m_y), 0),
+        std::min(floor_bank(m_y + m_height - 1) + 1, PCD8544::banks)};
+
+    if(rect.empty() || m_image.empty())
+        return {};
+
+    return rect;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+SpriteEngine::SpriteEngine(PCD8544& lcd,
+    const std::span<const std::uint8_t, PCD8544::screen_width * PCD8544::banks>
+        background,
+    const std::span<Sprite> sprites) noexcept
+    : m_lcd(lcd), m_background(background), m_sprites(sprites)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpriteEngine::redraw() noexcept
+{
+    for(auto& sprite : m_sprites)
+    {
+        sprite.m_drawn   = sprite.bounds();
+        sprite.m_shown   = sprite.m_visible;
+        sprite.m_changed = false;
+    }
+
+    m_rect_count = 0;
+    paint({0, PCD8544::screen_width, 0, PCD8544::banks});
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpriteEngine::update() noexcept
+{
+    for(auto& sprite : m_sprites)
+    {
+        if(!sprite.m_changed)
+            continue;
+
+        // erase the old position and draw the new one
+        if(sprite.m_shown)
+            add(sprite.m_drawn);
+
+        sprite.m_drawn = sprite.bounds();
+        sprite.m_shown = sprite.m_visible;
+
+        if(sprite.m_shown)
+            add(sprite.m_drawn);
+
+        sprite.m_changed = false;
+    }
+
+    for(int n{}; n != m_rect_count; ++n)
+        paint(m_rects[static_cast<std::size_t>(n)]);
+
+    m_rect_count = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+void Sprite::draw(const int bank, const int x0, const int x1,
+    const std::span<std::uint8_t> row) const noexcept
+{
+    // sprite row at the top of the bank, may be negative
+    const int top{(bank * PCD8544::pixels_per_bank) - m_y};
+    const std::uint64_t rows{(std::uint64_t{1} << m_height) - 1U};
+
+    const int first{std::max(x0, m_x)};
+    const int last{std::min(x1, m_x + m_width)};
+
+    for(int x{first}; x < last; ++x)
+    {
+        const auto col = static_cast<std::size_t>(x - m_x);
+
+        std::uint64_t image{};
+        std::uint64_t mask{};
+        for(int b{}; b != m_banks; ++b)
+        {
+            const auto n = (static_cast<std::size_t>(b * m_width)) + col;
+            const auto shift = static_cast<unsigned int>(8 * b);
+
+            image |= std::uint64_t{m_image[n]} << shift;
+            if(!m_mask.empty())
+                mask |= std::uint64_t{m_mask[n]} << shift;
+        }
+
+        if(m_mask.empty())
+            mask = image;
+
+        image &= rows;
+        mask &= rows;
+
+        const auto offset = static_cast<unsigned int>(std::abs(top));
+        const auto i = static_cast<std::uint8_t>(
+            (top >= 0) ? (image >> offset) : (image << offset));
+        const auto m = static_cast<std::uint8_t>(
+            (top >= 0) ? (mask >> offset) : (mask << offset));
+
+        auto& pixels = row[static_cast<std::size_t>(x)];
+        pixels = static_cast<std::uint8_t>((pixels & ~m) | (i & m));
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpriteEngine::add(BankRect rect) noexcept
+{
+    if(rect.empty())
+        return;
+
+    // merging can make the rectangle overlap others, so repeat until stable
+    for(int n{}; n != m_rect_count;)
+    {
+        auto& other = m_rects[static_cast<std::size_t>(n)];
+        if(overlaps(rect, other))
+        {
+            rect  = unite(rect, other);
+            other = m_rects[static_cast<std::size_t>(--m_rect_count)];
+            n     = 0;
+        }
+        else
+        {
+            ++n;
+        }
+    }
+
+    if(m_rect_count == max_rects)
+    {
+        auto& last = m_rects[static_cast<std::size_t>(max_rects - 1)];
+        last       = unite(last, rect);
+        return;
+    }
+
+    m_rects[static_cast<std::size_t>(m_rect_count++)] = rect;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void SpriteEngine::paint(const BankRect& rect) noexcept
+{
+    std::array<std::uint8_t, PCD8544::screen_width> row{};
+
+    const auto x0 = static_cast<std::size_t>(rect.x0);
+    const auto width = static_cast<std::size_t>(rect.x1 - rect.x0);
+
+    for(int bank{rect.bank0}; bank != rect.bank1; ++bank)
+    {
+        const auto background = m_background.subspan(
+            (static_cast<std::size_t>(bank * PCD8544::screen_width)) + x0,
+            width);
+        std::copy(background.begin(), background.end(), row.begin() + x0);
+
+        // sprites later in the list are drawn on top
+        for(const auto& sprite : m_sprites)
+        {
+            const auto& bounds = sprite.m_drawn;
+            if(sprite.m_shown && (bank >= bounds.bank0) &&
+                (bank < bounds.bank1))
+                sprite.draw(bank, rect.x0, rect.x1, row);
+        }
+
+        m_lcd.draw_bitmap(rect.x0, bank, rect.x1 - rect.x0, 1,
+            std::span{row}.subspan(x0), PCD8544::screen_width);
+    }
+}
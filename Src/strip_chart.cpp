@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "strip_chart.hpp"
+
+#include "pcd8544.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Data
+////////////////////////////////////////////////////////////////////////////////
+
+// pixel rows n and below, and n and above, within a bank byte (LSB is top)
+static constexpr auto rows_from = [] {
+    std::array<std::uint8_t, PCD8544::pixels_per_bank> masks{};
+    for(unsigned int n{}; n != masks.size(); ++n)
+        masks[n] = static_cast<std::uint8_t>(0xFFU << n);
+    return masks;
+}();
+
+static constexpr auto rows_to = [] {
+    std::array<std::uint8_t, PCD8544::pixels_per_bank> masks{};
+    for(unsigned int n{}; n != masks.size(); ++n)
+        masks[n] = static_cast<std::uint8_t>(0xFFU >> (7U - n));
+    return masks;
+}();
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+StripChart::StripChart(PCD8544& lcd, const int x, const int bank,
+    const int width, const int bank_count, const Mode mode) noexcept
+    : m_lcd(lcd), m_x(std::clamp(x, 0, PCD8544::screen_width - 1)),
+      m_bank(std::clamp(bank, 0, PCD8544::banks - 1)),
+      m_width(std::clamp(width, 1, PCD8544::screen_width - m_x)),
+      m_bank_count(std::clamp(bank_count, 1, PCD8544::banks - m_bank)),
+      m_mode(mode)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void StripChart::push(const int value) noexcept
+{
+    const int height{m_bank_count * PCD8544::pixels_per_bank};
+
+    m_samples[static_cast<std::size_t>(m_head)] =
+        static_cast<std::uint8_t>(std::clamp(value, 0, height - 1));
+    m_head  = (m_head + 1) % m_width;
+    m_count = std::min(m_count + 1, m_width);
+
+    if(m_mode == Mode::scroll)
+    {
+        redraw();
+        return;
+    }
+
+    // new column followed by an erase-ahead column, one burst for a full
+    // height chart
+    std::array<std::uint8_t, 2 * PCD8544::banks> columns{};
+
+    const auto current = render(sample(m_count > 1 ? 1 : 0), sample(0));
+    std::copy_n(current.begin(), m_bank_count, columns.begin());
+
+    const auto column_size = static_cast<std::size_t>(m_bank_count);
+    const bool wraps{m_cursor + 1 == m_width};
+
+    m_lcd.draw_columns(m_x + m_cursor, m_bank, m_bank_count,
+        std::span{columns}.first((wraps ? 1U : 2U) * column_size));
+
+    // at the right edge the column ahead is the first one
+    if(wraps && (m_width > 1))
+        m_lcd.draw_columns(m_x, m_bank, m_bank_count,
+            std::span{columns}.subspan(column_size, column_size));
+
+    m_cursor = (m_cursor + 1) % m_width;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void StripChart::redraw() noexcept
+{
+    // one bank row at a time, so the stack holds 84 bytes rather than the
+    // whole window, at the cost of rendering each column once per bank
+    std::array<std::uint8_t, PCD8544::screen_width> row{};
+
+    for(int bank{}; bank != m_bank_count; ++bank)
+    {
+        for(int col{}; col != m_width; ++col)
+        {
+            // scroll is right aligned with the oldest sample on the left,
+            // sweep keeps every sample where the cursor drew it and blanks
+            // ahead of it
+            const int age{(m_mode == Mode::scroll)
+                              ? (m_width - 1 - col)
+                              : ((m_cursor - 1 - col + m_width) % m_width)};
+
+            auto& byte = row[static_cast<std::size_t>(col)];
+            byte       = 0U;
+
+            if((age >= m_count) ||
+               ((m_mode == Mode::sweep) && (col == m_cursor)))
+                continue;
+
+            const int previous{std::min(age + 1, m_count - 1)};
+            byte = render(sample(previous),
+                sample(age))[static_cast<std::size_t>(bank)];
+        }
+
+        m_lcd.draw_bitmap(m_x, m_bank + bank, m_width, 1,
+            std::span{row}.first(static_cast<std::size_t>(m_width)), m_width);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void StripChart::clear() noexcept
+{
+    m_head   = 0;
+    m_count  = 0;
+    m_cursor = 0;
+
+    redraw();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+StripChart::Column StripChart::render(
+    const int previous, const int sample) const noexcept
+{
+    const int bottom{(m_bank_count * PCD8544::pixels_per_bank) - 1};
+
+    // rows counted from the top of the chart
+    const int top_row{bottom - std::max(previous, sample)};
+    const int end_row{bottom - std::min(previous, sample)};
+
+    Column column{};
+    for(int bank{}; bank != m_bank_count; ++bank)
+    {
+        const int first{bank * PCD8544::pixels_per_bank};
+        const int last{first + PCD8544::pixels_per_bank - 1};
+
+        if((end_row < first) || (top_row > last))
+            continue;
+
+        const auto from =
+            static_cast<std::size_t>(std::max(top_row, first) - first);
+        const auto to =
+            static_cast<std::size_t>(std::min(end_row, last) - first);
+
+        column[static_cast<std::size_t>(bank)] = rows_from[from] & rows_to[to];
+    }
+
+    return column;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+int StripChart::sample(const int age) const noexcept
+{
+    const int n{(m_head - 1 - age + (2 * m_width)) % m_width};
+    return m_samples[static_cast<std::size_t>(n)];
+}
@@ -0,0 +1,226 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "strip_renderer.hpp"
+
+#include "compositor.hpp"
+#include "font.hpp"
+#include "pcd8544.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Functions
+////////////////////////////////////////////////////////////////////////////////
+
+using Strip = std::span<std::uint8_t, PCD8544::screen_width>;
+
+////////////////////////////////////////////////////////////////////////////////
+static constexpr int floor_div8(const int n) noexcept
+{
+    return (n >= 0) ? (n / 8) : -((7 - n) / 8);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static constexpr std::uint8_t apply(const RasterOp op, const std::uint8_t dst,
+    const std::uint8_t src, const std::uint8_t cover) noexcept
+{
+    const auto pixels = static_cast<std::uint8_t>(src & cover);
+
+    // clang-format off
+    switch(op)
+    {
+    case RasterOp::bit_or:  return dst | pixels;
+    case RasterOp::bit_and: return dst & (pixels | ~cover);
+    case RasterOp::bit_xor: return dst ^ pixels;
+    case RasterOp::mask:    return dst & ~pixels;
+    }
+    // clang-format on
+
+    return dst;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static constexpr std::uint8_t coverage(
+    const int bank, const int y, const int height) noexcept
+{
+    // pixel rows [y, y + height) relative to the top of the bank
+    const int top{std::clamp(y - (bank * 8), 0, 8)};
+    const int bottom{std::clamp(y + height - (bank * 8), 0, 8)};
+
+    const unsigned int below{(1U << static_cast<unsigned int>(top)) - 1U};
+    const unsigned int above{(1U << static_cast<unsigned int>(bottom)) - 1U};
+
+    return static_cast<std::uint8_t>(above & ~below);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void blit(const Strip strip, const int bank, const int x, const int y,
+    const int width, const int height,
+    const std::span<const std::uint8_t> image, const RasterOp op) noexcept
+{
+    const auto cover = coverage(bank, y, height);
+    if(cover == 0U)
+        return;
+
+    // the bank straddles two image banks unless the image is bank aligned
+    const int top{(bank * 8) - y};
+    const int source{floor_div8(top)};
+    const auto shift = static_cast<unsigned int>(top - (source * 8));
+    const int image_banks{(height + 7) / 8};
+
+    const auto row = [&](const int b, const int col) -> unsigned int
+    {
+        if((b < 0) || (b >= image_banks))
+            return 0U;
+
+        return image[static_cast<std::size_t>((b * width) + col)];
+    };
+
+    const int first{std::max(x, 0)};
+    const int last{std::min(x + width, PCD8544::screen_width)};
+
+    for(int col{first}; col < last; ++col)
+    {
+        const unsigned int pixels{
+            (row(source, col - x) | (row(source + 1, col - x) << 8U)) >> shift};
+
+        auto& dst = strip[static_cast<std::size_t>(col)];
+        dst = apply(op, dst, static_cast<std::uint8_t>(pixels), cover);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void fill(
+    const Strip strip, const int bank, const DisplayItem& item) noexcept
+{
+    const auto cover = coverage(bank, item.y, item.height);
+    if(cover == 0U)
+        return;
+
+    const int first{std::max(item.x, 0)};
+    const int last{std::min(item.x + item.width, PCD8544::screen_width)};
+
+    for(int col{first}; col < last; ++col)
+    {
+        auto& dst = strip[static_cast<std::size_t>(col)];
+        dst       = apply(item.op, dst, 0xFFU, cover);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void text(
+    const Strip strip, const int bank, const DisplayItem& item) noexcept
+{
+    const Font& font = *item.font;
+    if(coverage(bank, item.y, item.height) == 0U)
+        return;
+
+    int x{item.x};
+    for(const auto c : item.text)
+    {
+        if(x >= PCD8544::screen_width)
+            break;
+
+        const auto uc = static_cast<unsigned char>(c);
+        const int width{font.glyph_width(uc)};
+        const auto glyph = font.glyph(uc);
+
+        // fixed width fonts report the full width even for missing glyphs
+        if((x + width > 0) &&
+            (glyph.size() >= static_cast<std::size_t>(width * font.banks)))
+            blit(strip, bank, x, item.y, width, item.height, glyph, item.op);
+
+        x += font.advance(uc);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+static void rasterize(
+    const Strip strip, const int bank, const DisplayItem& item) noexcept
+{
+    switch(item.kind)
+    {
+    case DisplayItem::Kind::text:
+        if(item.font != nullptr)
+            text(strip, bank, item);
+        break;
+
+    case DisplayItem::Kind::rect:
+        fill(strip, bank, item);
+        break;
+
+    case DisplayItem::Kind::bitmap:
+        if((item.width > 0) && (item.height > 0) &&
+            (item.bitmap.size() >= static_cast<std::size_t>(
+                                       item.width * ((item.height + 7) / 8))))
+            blit(strip, bank, item.x, item.y, item.width, item.height,
+                item.bitmap, item.op);
+        break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+StripRenderer::StripRenderer(PCD8544& lcd) noexcept : m_lcd(lcd)
+{
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void StripRenderer::render(const std::span<const DisplayItem> items) noexcept
+{
+    render(items, 0, PCD8544::banks);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void StripRenderer::render(const std::span<const DisplayItem> items,
+    const int bank, const int bank_count) noexcept
+{
+    const int first{std::max(bank, 0)};
+    const int last{std::min(bank + bank_count, PCD8544::banks)};
+
+    std::array<std::uint8_t, PCD8544::screen_width> strip{};
+
+    for(int b{first}; b < last; ++b)
+    {
+        strip.fill(0U);
+
+        for(const auto& item : items)
+            rasterize(strip, b, item);
+
+        // consecutive full width strips continue at the next bank, so only
+        // the first one sends an address
+        m_lcd.draw_bitmap(
+            0, b, PCD8544::screen_width, 1, strip, PCD8544::screen_width);
+    }
+}
@@ -24,6 +24,13 @@
 #include <errno.h>
 #include <stdint.h>
 
+#ifdef PCD8544_HEAP_GUARD
+/**
+ * Counts heap growth for HeapGuard, see heap_guard.hpp
+ */
+void heap_guard_sbrk(void);
+#endif
+
 /**
  * Pointer to the current high watermark of the heap usage
  */
@@ -59,6 +66,10 @@ void *_sbrk(ptrdiff_t incr)
   const uint8_t *max_heap = (uint8_t *)stack_limit;
   uint8_t *prev_heap_end;
 
+#ifdef PCD8544_HEAP_GUARD
+  heap_guard_sbrk();
+#endif
+
   /* Initialize heap end at first call */
   if (NULL == __sbrk_heap_end)
   {
@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "utf8.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Static Data
+////////////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+////////////////////////////////////////////////////////////////////////////////
+// byte classes followed by state transitions, states are multiples of 12
+static constexpr std::array<std::uint8_t, 364> utf8_dfa
+{
+    // 0x00-0x7F
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+
+    // 0x80-0xFF
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+    8, 8, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+    10, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 3, 3,
+    11, 6, 6, 6, 5, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8,
+
+    // transitions
+     0, 12, 24, 36, 60, 96, 84, 12, 12, 12, 48, 72,
+    12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+    12,  0, 12, 12, 12, 12, 12,  0, 12,  0, 12, 12,
+    12, 24, 12, 12, 12, 12, 12, 24, 12, 24, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 24, 12, 12, 12, 12,
+    12, 24, 12, 12, 12, 12, 12, 12, 12, 24, 12, 12,
+    12, 12, 12, 12, 12, 12, 12, 36, 12, 36, 12, 12,
+    12, 36, 12, 12, 12, 12, 12, 36, 12, 36, 12, 12,
+    12, 36, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// code points with a CP437 glyph outside of printable ASCII, sorted
+static constexpr std::array<std::uint16_t, 168> cp437_code_points
+{
+    0x00a0U, 0x00a1U, 0x00a2U, 0x00a3U, 0x00a5U, 0x00a7U, 0x00aaU, 0x00abU,
+    0x00acU, 0x00b0U, 0x00b1U, 0x00b2U, 0x00b5U, 0x00b6U, 0x00b7U, 0x00baU,
+    0x00bbU, 0x00bcU, 0x00bdU, 0x00bfU, 0x00c4U, 0x00c5U, 0x00c6U, 0x00c7U,
+    0x00c9U, 0x00d1U, 0x00d6U, 0x00dcU, 0x00dfU, 0x00e0U, 0x00e1U, 0x00e2U,
+    0x00e4U, 0x00e5U, 0x00e6U, 0x00e7U, 0x00e8U, 0x00e9U, 0x00eaU, 0x00ebU,
+    0x00ecU, 0x00edU, 0x00eeU, 0x00efU, 0x00f1U, 0x00f2U, 0x00f3U, 0x00f4U,
+    0x00f6U, 0x00f7U, 0x00f8U, 0x00f9U, 0x00faU, 0x00fbU, 0x00fcU, 0x00ffU,
+    0x0192U, 0x0393U, 0x0398U, 0x03a3U, 0x03a6U, 0x03a9U, 0x03b1U, 0x03b4U,
+    0x03b5U, 0x03c0U, 0x03c3U, 0x03c4U, 0x03c6U, 0x03d5U, 0x2022U, 0x203cU,
+    0x207fU, 0x20a7U, 0x2126U, 0x2190U, 0x2191U, 0x2192U, 0x2193U, 0x2194U,
+    0x2195U, 0x21a8U, 0x2205U, 0x2208U, 0x220aU, 0x2211U, 0x2219U, 0x221aU,
+    0x221eU, 0x221fU, 0x2229U, 0x2248U, 0x2261U, 0x2264U, 0x2265U, 0x2302U,
+    0x2310U, 0x2320U, 0x2321U, 0x2500U, 0x2502U, 0x250cU, 0x2510U, 0x2514U,
+    0x2518U, 0x251cU, 0x2524U, 0x252cU, 0x2534U, 0x253cU, 0x2550U, 0x2551U,
+    0x2552U, 0x2553U, 0x2554U, 0x2555U, 0x2556U, 0x2557U, 0x2558U, 0x2559U,
+    0x255aU, 0x255bU, 0x255cU, 0x255dU, 0x255eU, 0x255fU, 0x2560U, 0x2561U,
+    0x2562U, 0x2563U, 0x2564U, 0x2565U, 0x2566U, 0x2567U, 0x2568U, 0x2569U,
+    0x256aU, 0x256bU, 0x256cU, 0x2580U, 0x2584U, 0x2588U, 0x258cU, 0x2590U,
+    0x2591U, 0x2592U, 0x2593U, 0x25a0U, 0x25acU, 0x25b2U, 0x25baU, 0x25bcU,
+    0x25c4U, 0x25cbU, 0x25d8U, 0x25d9U, 0x263aU, 0x263bU, 0x263cU, 0x2640U,
+    0x2642U, 0x2660U, 0x2663U, 0x2665U, 0x2666U, 0x266aU, 0x266bU, 0x2713U
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+static constexpr std::array<std::uint8_t, 168> cp437_glyphs
+{
+    0xffU, 0xadU, 0x9bU, 0x9cU, 0x9dU, 0x15U, 0xa6U, 0xaeU, 0xaaU, 0xf8U,
+    0xf1U, 0xfdU, 0xe6U, 0x14U, 0xfaU, 0xa7U, 0xafU, 0xacU, 0xabU, 0xa8U,
+    0x8eU, 0x8fU, 0x92U, 0x80U, 0x90U, 0xa5U, 0x99U, 0x9aU, 0xe1U, 0x85U,
+    0xa0U, 0x83U, 0x84U, 0x86U, 0x91U, 0x87U, 0x8aU, 0x82U, 0x88U, 0x89U,
+    0x8dU, 0xa1U, 0x8cU, 0x8bU, 0xa4U, 0x95U, 0xa2U, 0x93U, 0x94U, 0xf6U,
+    0xedU, 0x97U, 0xa3U, 0x96U, 0x81U, 0x98U, 0x9fU, 0xe2U, 0xe9U, 0xe4U,
+    0xe8U, 0xeaU, 0xe0U, 0xebU, 0xeeU, 0xe3U, 0xe5U, 0xe7U, 0xedU, 0xedU,
+    0x07U, 0x13U, 0xfcU, 0x9eU, 0xeaU, 0x1bU, 0x18U, 0x1aU, 0x19U, 0x1dU,
+    0x12U, 0x17U, 0xedU, 0xeeU, 0xeeU, 0xe4U, 0xf9U, 0xfbU, 0xecU, 0x1cU,
+    0xefU, 0xf7U, 0xf0U, 0xf3U, 0xf2U, 0x7fU, 0xa9U, 0xf4U, 0xf5U, 0xc4U,
+    0xb3U, 0xdaU, 0xbfU, 0xc0U, 0xd9U, 0xc3U, 0xb4U, 0xc2U, 0xc1U, 0xc5U,
+    0xcdU, 0xbaU, 0xd5U, 0xd6U, 0xc9U, 0xb8U, 0xb7U, 0xbbU, 0xd4U, 0xd3U,
+    0xc8U, 0xbeU, 0xbdU, 0xbcU, 0xc6U, 0xc7U, 0xccU, 0xb5U, 0xb6U, 0xb9U,
+    0xd1U, 0xd2U, 0xcbU, 0xcfU, 0xd0U, 0xcaU, 0xd8U, 0xd7U, 0xceU, 0xdfU,
+    0xdcU, 0xdbU, 0xddU, 0xdeU, 0xb0U, 0xb1U, 0xb2U, 0xfeU, 0x16U, 0x1eU,
+    0x10U, 0x1fU, 0x11U, 0x09U, 0x08U, 0x0aU, 0x01U, 0x02U, 0x0fU, 0x0cU,
+    0x0bU, 0x06U, 0x05U, 0x03U, 0x04U, 0x0dU, 0x0eU, 0xfbU
+};
+// clang-format on
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+std::uint8_t Utf8Decoder::decode(const std::uint8_t byte) noexcept
+{
+    const std::uint8_t type{utf8_dfa[byte]};
+
+    // continuation bytes add six bits, lead bytes are masked by their class
+    m_code_point = (m_state != accept)
+                       ? ((byte & 0x3FU) | (m_code_point << 6U))
+                       : ((0xFFU >> type) & byte);
+
+    m_state = utf8_dfa[256U + m_state + type];
+
+    return m_state;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+char32_t Utf8Decoder::code_point() const noexcept
+{
+    return m_code_point;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Utf8Decoder::reset() noexcept
+{
+    m_state      = accept;
+    m_code_point = 0;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Non-Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+unsigned char to_cp437(const char32_t code_point) noexcept
+{
+    if((code_point >= U' ') && (code_point < U'\x7F'))
+        return static_cast<unsigned char>(code_point);
+
+    // binary search, at most eight probes
+    const auto it = std::lower_bound(
+        cp437_code_points.begin(), cp437_code_points.end(), code_point);
+
+    if((it == cp437_code_points.end()) || (*it != code_point))
+        return '?';
+
+    return cp437_glyphs[static_cast<std::size_t>(
+        std::distance(cp437_code_points.begin(), it))];
+}
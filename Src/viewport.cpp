@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////////////////////////
+// PCD8544 Library
+// Copyright 2022 Ryan Clarke
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "viewport.hpp"
+
+#include "pcd8544.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+Viewport::Viewport(PCD8544& lcd, const int x, const int bank, const int width,
+    const int bank_count) noexcept
+    : m_lcd(lcd), m_x(std::clamp(x, 0, PCD8544::screen_width - 1)),
+      m_bank(std::clamp(bank, 0, PCD8544::banks - 1)),
+      m_width(std::clamp(width, 1, PCD8544::screen_width - m_x)),
+      m_bank_count(std::clamp(bank_count, 1, PCD8544::banks - m_bank)),
+      m_cell_width(std::max(lcd.font().width, 1)),
+      m_columns(std::clamp(m_width / m_cell_width, 1, max_columns))
+{
+    m_text.fill(' ');
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Viewport::set_wrap(const bool wrap) noexcept
+{
+    m_wrap = wrap;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Viewport::set_scroll(const bool scroll) noexcept
+{
+    m_scroll = scroll;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Viewport::set_cursor(const int column, const int row) noexcept
+{
+    // % keeps the sign of a negative argument, so wrap it into range
+    m_column = ((column % m_columns) + m_columns) % m_columns;
+    m_row    = ((row % m_bank_count) + m_bank_count) % m_bank_count;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Viewport::print(const char c)
+{
+    if((c < ' ') || (c == '\x7F'))
+    {
+        // clang-format off
+        switch(c)
+        {
+        case '\n': new_line(); break;
+        case '\f': clear(); break;
+        case '\r': m_column = 0; break;
+        default:   break;
+        }
+        // clang-format on
+
+        return;
+    }
+
+    if(m_column == m_columns)
+    {
+        if(!m_wrap)
+            return;
+
+        new_line();
+    }
+
+    cell(m_column, m_row) = c;
+    draw_cell(m_column, m_row);
+
+    ++m_column;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Viewport::print(const std::string_view s)
+{
+    for(const auto c : s)
+        print(c);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Viewport::clear() noexcept
+{
+    m_text.fill(' ');
+    m_column = 0;
+    m_row    = 0;
+
+    m_lcd.fill(m_x, m_bank, m_width, m_bank_count, 0U);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Viewport::redraw() noexcept
+{
+    // consecutive cells on a row are contiguous, so each row costs a single
+    // address set
+    for(int row{}; row != m_bank_count; ++row)
+        for(int column{}; column != m_columns; ++column)
+            draw_cell(column, row);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Private Member Functions
+////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////
+void Viewport::draw_cell(const int column, const int row) noexcept
+{
+    const auto c     = static_cast<unsigned char>(cell(column, row));
+    const auto glyph = m_lcd.font().glyph(c);
+    const int x{m_x + (column * m_cell_width)};
+
+    // a viewport narrower than a cell shows the left part of its one column
+    const int width{std::min(m_cell_width, m_x + m_width - x)};
+
+    if(glyph.size() < static_cast<std::size_t>(m_cell_width))
+    {
+        m_lcd.fill(x, m_bank + row, width, 1, 0U);
+        return;
+    }
+
+    m_lcd.draw_bitmap(x, m_bank + row, width, 1, glyph, m_cell_width);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+void Viewport::new_line() noexcept
+{
+    m_column = 0;
+
+    if(m_row + 1 < m_bank_count)
+    {
+        ++m_row;
+        return;
+    }
+
+    if(!m_scroll)
+    {
+        m_row = 0;
+        return;
+    }
+
+    const auto stride = static_cast<std::ptrdiff_t>(max_columns);
+    std::copy(m_text.begin() + stride, m_text.end(), m_text.begin());
+    std::fill(m_text.end() - stride, m_text.end(), ' ');
+
+    redraw();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+char& Viewport::cell(const int column, const int row) noexcept
+{
+    return m_text[static_cast<std::size_t>((row * max_columns) + column)];
+}
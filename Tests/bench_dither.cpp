@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+// Dither throughput for both methods on a full screen 84x48 and a 32x16 icon
+// sized 8-bit source. The output is checked against straightforward
+// whole-image reference implementations, which also keeps the timed
+// conversions from being optimised away.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "check.hpp"
+
+#include "dither.hpp"
+#include "pcd8544.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+
+static constexpr int iterations{2000};
+
+
+// a horizontal ramp with a vertical ripple, so every threshold is crossed
+static std::vector<std::uint8_t> source(const int width, const int height)
+{
+    std::vector<std::uint8_t> gray(static_cast<std::size_t>(width * height));
+
+    for(int y{}; y != height; ++y)
+    {
+        for(int x{}; x != width; ++x)
+        {
+            const int ramp{(x * 255) / (width - 1)};
+            const int ripple{((y * 37) % 64) - 32};
+            gray[static_cast<std::size_t>((y * width) + x)] =
+                static_cast<std::uint8_t>(std::clamp(ramp + ripple, 0, 255));
+        }
+    }
+
+    return gray;
+}
+
+
+// bank-major 1bpp output of the 8x8 Bayer matrix, threshold per pixel
+static std::vector<std::uint8_t> reference_ordered(
+    const std::vector<std::uint8_t>& gray, const int width, const int height)
+{
+    // clang-format off
+    static constexpr std::array<std::array<int, 8>, 8> bayer{{
+        {{  2, 130,  34, 162,  10, 138,  42, 170}},
+        {{194,  66, 226,  98, 202,  74, 234, 106}},
+        {{ 50, 178,  18, 146,  58, 186,  26, 154}},
+        {{242, 114, 210,  82, 250, 122, 218,  90}},
+        {{ 14, 142,  46, 174,   6, 134,  38, 166}},
+        {{206,  78, 238, 110, 198,  70, 230, 102}},
+        {{ 62, 190,  30, 158,  54, 182,  22, 150}},
+        {{254, 126, 222,  94, 246, 118, 214,  86}}
+    }};
+    // clang-format on
+
+    std::vector<std::uint8_t> out(
+        static_cast<std::size_t>(width * ((height + 7) / 8)));
+
+    for(int y{}; y != height; ++y)
+    {
+        for(int x{}; x != width; ++x)
+        {
+            const int g{gray[static_cast<std::size_t>((y * width) + x)]};
+            if(g < bayer[static_cast<std::size_t>(x & 7)]
+                        [static_cast<std::size_t>(y & 7)])
+                out[static_cast<std::size_t>(((y / 8) * width) + x)] |=
+                    static_cast<std::uint8_t>(1U << (y & 7));
+        }
+    }
+
+    return out;
+}
+
+
+// Floyd-Steinberg over the whole image with a full error plane
+static std::vector<std::uint8_t> reference_diffusion(
+    const std::vector<std::uint8_t>& gray, const int width, const int height)
+{
+    std::vector<int> error(
+        static_cast<std::size_t>((width + 2) * (height + 1)));
+    const auto at = [&](const int x, const int y) -> int&
+    {
+        return error[static_cast<std::size_t>((y * (width + 2)) + x + 1)];
+    };
+
+    std::vector<std::uint8_t> out(
+        static_cast<std::size_t>(width * ((height + 7) / 8)));
+
+    for(int y{}; y != height; ++y)
+    {
+        for(int x{}; x != width; ++x)
+        {
+            const int value{
+                gray[static_cast<std::size_t>((y * width) + x)] + at(x, y)};
+            const bool set{value < 128};
+
+            if(set)
+                out[static_cast<std::size_t>(((y / 8) * width) + x)] |=
+                    static_cast<std::uint8_t>(1U << (y & 7));
+
+            const int e{value - (set ? 0 : 255)};
+            if(x + 1 < width)
+                at(x + 1, y) += (e * 7) / 16;
+            at(x - 1, y + 1) += (e * 3) / 16;
+            at(x, y + 1) += (e * 5) / 16;
+            at(x + 1, y + 1) += e / 16;
+        }
+    }
+
+    return out;
+}
+
+
+static void bench(const char* const name, const Dither::Method method,
+    const int width, const int height)
+{
+    using clock = std::chrono::steady_clock;
+
+    const auto gray = source(width, height);
+    const auto expected = (method == Dither::Method::ordered)
+                              ? reference_ordered(gray, width, height)
+                              : reference_diffusion(gray, width, height);
+
+    Dither dither{gray, width, height, method};
+    std::vector<std::uint8_t> out(expected.size());
+    std::array<std::uint8_t, Dither::max_width> strip{};
+
+    const auto start = clock::now();
+
+    for(int n{}; n != iterations; ++n)
+    {
+        dither.reset();
+        for(int bank{}; dither.next(strip); ++bank)
+        {
+            std::copy_n(strip.begin(), width,
+                out.begin() + (bank * static_cast<std::ptrdiff_t>(width)));
+        }
+    }
+
+    const double seconds{
+        std::chrono::duration<double>(clock::now() - start).count()};
+
+    CHECK(out == expected);
+
+    const double pixels{static_cast<double>(width) * height * iterations};
+    const double banks{static_cast<double>(dither.banks()) * iterations};
+
+    std::printf("  %-16s %2dx%-2d %8.1f Mpixel/s %8.1f ns per bank\n", name,
+        width, height, pixels / seconds / 1.0e6, seconds * 1.0e9 / banks);
+}
+
+
+int main()
+{
+    std::printf("dither throughput, %d conversions each:\n", iterations);
+
+    for(const auto& size : {std::array{84, 48}, std::array{32, 16}})
+    {
+        bench("ordered", Dither::Method::ordered, size[0], size[1]);
+        bench("error diffusion", Dither::Method::error_diffusion, size[0],
+            size[1]);
+    }
+
+    return check_result("bench_dither");
+}
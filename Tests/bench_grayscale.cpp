@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////////////////////////
+// Grayscale subframe cost over representative images: SPI bytes and cycle
+// counter cycles per subframe, and from the bytes the gray frame rate that
+// 1, 2, 4 and 8 MHz SPI clocks allow, against the subframe rate below which
+// flicker shows. A model of display RAM, fed from the SPI log, checks that
+// every subframe reaches the screen intact.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "check.hpp"
+#include "spi_model.hpp"
+
+#include "grayscale.hpp"
+#include "pcd8544.hpp"
+#include "spi_bus.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+
+static GPIO_TypeDef sce_port{};
+static GPIO_TypeDef rst_port{};
+static GPIO_TypeDef dc_port{};
+static constexpr std::uint32_t sce_pin{1U};
+static constexpr std::uint32_t rst_pin{2U};
+static constexpr std::uint32_t dc_pin{4U};
+
+static SpiBus bus{SPI1};
+
+static constexpr int size{Grayscale::size};
+using Plane = std::array<std::uint8_t, size>;
+using Gray  = std::array<std::uint8_t,
+    PCD8544::screen_width * PCD8544::screen_height / 4>;
+
+// gray frames timed per image, after the first full subframe
+static constexpr int frames{20};
+
+// subframe rate that avoids visible flicker on most glass
+static constexpr double flicker_free_hz{50.0};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Display RAM rebuilt from the bytes on the bus.
+////////////////////////////////////////////////////////////////////////////////
+struct Ram
+{
+    Plane pixels{};
+    int x{0};
+    int y{0};
+    bool extended{false};
+    bool vertical{false};
+    std::size_t seen{0};
+
+    void command(const std::uint8_t c)
+    {
+        if((c & 0xF8U) == 0x20U)
+        {
+            extended = (c & 0x01U) != 0U;
+            vertical = (c & 0x02U) != 0U;
+        }
+        else if(!extended && ((c & 0x80U) != 0U))
+        {
+            x = c & 0x7FU;
+        }
+        else if(!extended && ((c & 0xF8U) == 0x40U))
+        {
+            y = c & 0x07U;
+        }
+    }
+
+    void data(const std::uint8_t d)
+    {
+        pixels[static_cast<std::size_t>((y * PCD8544::screen_width) + x)] = d;
+
+        if(vertical)
+        {
+            if(++y == PCD8544::banks)
+            {
+                y = 0;
+                x = (x + 1) % PCD8544::screen_width;
+            }
+        }
+        else if(++x == PCD8544::screen_width)
+        {
+            x = 0;
+            y = (y + 1) % PCD8544::banks;
+        }
+    }
+
+    void update()
+    {
+        for(; seen != spi_model.log.size(); ++seen)
+        {
+            const auto& b = spi_model.log[seen];
+            if(b.data)
+                data(b.value);
+            else
+                command(b.value);
+        }
+    }
+};
+
+static Ram ram{};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Test images, 2 bits per pixel, four pixels per byte, MSB first.
+////////////////////////////////////////////////////////////////////////////////
+template<typename Level>
+static Gray image(Level level)
+{
+    Gray gray{};
+
+    for(int y{}; y != PCD8544::screen_height; ++y)
+    {
+        for(int x{}; x != PCD8544::screen_width; ++x)
+        {
+            const auto shift = static_cast<unsigned int>(6 - ((x % 4) * 2));
+            auto& byte =
+                gray[static_cast<std::size_t>((y * PCD8544::screen_width / 4) +
+                                              (x / 4))];
+            const auto bits = static_cast<unsigned int>(level(x, y)) & 3U;
+            byte = static_cast<std::uint8_t>(byte | (bits << shift));
+        }
+    }
+
+    return gray;
+}
+
+
+static void bench(const char* const name, const Gray& gray, PCD8544& lcd)
+{
+    using clock = std::chrono::steady_clock;
+
+    Plane msb{};
+    Plane lsb{};
+    split_planes(gray, msb, lsb);
+
+    Grayscale grayscale{lcd, msb, lsb};
+
+    // the first subframe after an image change is sent in full
+    grayscale.step();
+    ram.update();
+
+    spi_model.clear();
+    ram.seen = 0;
+
+    const std::uint32_t cycles{DWT->CYCCNT};
+    const auto start = clock::now();
+    std::size_t worst{0};
+    int intact{0};
+
+    for(int n{}; n != frames * Grayscale::subframes; ++n)
+    {
+        const std::size_t before{spi_model.log.size()};
+        grayscale.step();
+        worst = std::max(worst, spi_model.log.size() - before);
+
+        // subframes run 1, 2, 0: msb, msb & lsb, msb | lsb
+        ram.update();
+        const int subframe{(n + 1) % Grayscale::subframes};
+        bool same{true};
+        for(std::size_t i{}; i != ram.pixels.size(); ++i)
+        {
+            const auto expected = (subframe == 0) ? (msb[i] | lsb[i])
+                                  : (subframe == 1) ? msb[i]
+                                                    : (msb[i] & lsb[i]);
+            same = same && (ram.pixels[i] == expected);
+        }
+        intact += same ? 1 : 0;
+    }
+
+    const double ns{
+        std::chrono::duration<double, std::nano>(clock::now() - start)
+            .count()};
+
+    CHECK(intact == frames * Grayscale::subframes);
+
+    const int count{frames * Grayscale::subframes};
+    const double bytes{static_cast<double>(spi_model.log.size()) / count};
+
+    std::printf("%s: %6.1f bytes (worst %3zu), %6u cycles, %7.0f ns per "
+                "subframe\n",
+        name, bytes, worst, (DWT->CYCCNT - cycles) / count, ns / count);
+
+    // two-level images stop sending once the first subframe is up
+    if(worst == 0U)
+    {
+        std::printf("  no SPI traffic, any subframe rate\n");
+        return;
+    }
+
+    // a byte is 8 SPI clocks; the slowest subframe sets the rate
+    for(const int mhz : {1, 2, 4, 8})
+    {
+        const double subframe_hz{
+            (mhz * 1.0e6) / (8.0 * static_cast<double>(worst))};
+        const double gray_hz{subframe_hz / Grayscale::subframes};
+        const double load{(flicker_free_hz * 8.0 * bytes) / (mhz * 1.0e6)};
+
+        std::printf("  %d MHz: %8.0f Hz gray frames, %5.1f%% of the bus at "
+                    "%.0f Hz subframes%s\n",
+            mhz, gray_hz, load * 100.0, flicker_free_hz,
+            (subframe_hz >= flicker_free_hz) ? "" : ", flickers");
+    }
+}
+
+
+int main()
+{
+    spi_model.dc_port = &dc_port;
+    spi_model.dc_pin  = dc_pin;
+    spi_model.log.reserve(1U << 20U);
+
+    PCD8544 lcd{bus, &sce_port, sce_pin, &rst_port, rst_pin, &dc_port, dc_pin};
+    ram.update();
+
+    // flat gray at level 2: every byte goes dark and back in the last subframe
+    bench("flat", image([](int, int) { return 2; }), lcd);
+
+    // four vertical bands, one per level
+    bench("bands", image([](const int x, int) { return (x * 4) / 84; }), lcd);
+
+    // black text on white: two levels, nothing changes after the first
+    bench("text",
+        image([](const int x, const int y)
+            { return (((x / 6) + (y / 8)) % 3 == 0) ? 3 : 0; }),
+        lcd);
+
+    // every level in every byte, the worst case for the difference coding
+    bench("noise",
+        image([](const int x, const int y)
+            { return static_cast<int>((x * 7U + y * 13U + x * y) % 4U); }),
+        lcd);
+
+    return check_result("bench_grayscale");
+}
@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+// StripRenderer against the full frame buffer path. The same animated display
+// list is drawn straight to the display one strip at a time, and into a frame
+// buffer that is flushed once per frame. Reports cycle counter cycles, which
+// the SPI model advances on every flag poll, SPI bytes, and host time per
+// frame, and checks that both paths end on the same picture.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "check.hpp"
+#include "spi_model.hpp"
+
+#include "font_6x8.hpp"
+#include "pcd8544.hpp"
+#include "spi_bus.hpp"
+#include "strip_renderer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+
+static GPIO_TypeDef sce_port{};
+static GPIO_TypeDef rst_port{};
+static GPIO_TypeDef dc_port{};
+static constexpr std::uint32_t sce_pin{1U};
+static constexpr std::uint32_t rst_pin{2U};
+static constexpr std::uint32_t dc_pin{4U};
+
+static SpiBus bus{SPI1};
+static std::array<std::uint8_t, PCD8544::screen_width * PCD8544::banks> fb{};
+
+static constexpr int frames{64};
+
+static constexpr std::array<std::uint8_t, 16 * 2> ball{
+    0xE0U, 0xF8U, 0xFCU, 0xFEU, 0xFEU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFEU, 0xFEU, 0xFCU, 0xF8U, 0xE0U,
+    0x07U, 0x1FU, 0x3FU, 0x7FU, 0x7FU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0x7FU, 0x7FU, 0x3FU, 0x1FU, 0x07U};
+
+
+struct Cost
+{
+    std::uint32_t cycles{0};
+    std::size_t bytes{0};
+    long long ns{0};
+};
+
+
+// a status line, a frame, a moving sprite and a scrolling caption
+static std::array<DisplayItem, 5> scene(const int frame)
+{
+    return {display_text(0, 0, "STRIP BENCH", font_6x8),
+        display_rect(0, 9, PCD8544::screen_width, 1),
+        display_rect(0, 47, PCD8544::screen_width, 1),
+        display_bitmap((frame * 3) % 68, 12 + ((frame * 5) % 20), 16, 16,
+            ball, RasterOp::bit_xor),
+        display_text(84 - ((frame * 2) % 140), 38, "scrolling caption",
+            font_6x8)};
+}
+
+
+template<typename Draw>
+static Cost measure(Draw draw)
+{
+    using clock = std::chrono::steady_clock;
+
+    spi_model.clear();
+    const std::uint32_t cycles{DWT->CYCCNT};
+    const auto start = clock::now();
+
+    for(int frame{}; frame != frames; ++frame)
+        draw(frame);
+
+    const auto ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() -
+                                                             start)
+            .count();
+
+    return {(DWT->CYCCNT - cycles) / frames, spi_model.log.size() / frames,
+        ns / frames};
+}
+
+
+static void report(const char* const name, const Cost& cost)
+{
+    std::printf("  %-13s %7u cycles %5zu bytes %8lld ns per frame\n", name,
+        cost.cycles, cost.bytes, cost.ns);
+}
+
+
+int main()
+{
+    spi_model.dc_port = &dc_port;
+    spi_model.dc_pin  = dc_pin;
+    spi_model.log.reserve(1U << 20U);
+
+    PCD8544 lcd{bus, &sce_port, sce_pin, &rst_port, rst_pin, &dc_port, dc_pin};
+    StripRenderer renderer{lcd};
+
+    const auto strips = measure([&](const int frame)
+        {
+            const auto items = scene(frame);
+            renderer.render(items);
+        });
+
+    // the last strip frame as it reached the display
+    std::vector<std::uint8_t> shown{};
+    for(const auto& b : spi_model.log)
+    {
+        if(b.data)
+            shown.push_back(b.value);
+    }
+    shown.erase(shown.begin(), shown.end() - static_cast<long>(fb.size()));
+
+    lcd.set_frame_buffer(fb);
+    lcd.flush();
+
+    const auto buffered = measure([&](const int frame)
+        {
+            const auto items = scene(frame);
+            renderer.render(items);
+            lcd.flush();
+        });
+
+    std::printf("%d frames of %zu items:\n", frames, scene(0).size());
+    report("strips", strips);
+    report("frame buffer", buffered);
+
+    CHECK(strips.bytes >= fb.size());
+    CHECK(buffered.bytes < strips.bytes);
+    CHECK(std::equal(shown.begin(), shown.end(), fb.begin(), fb.end()));
+
+    return check_result("bench_strip_renderer");
+}
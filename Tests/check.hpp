@@ -0,0 +1,29 @@
+////////////////////////////////////////////////////////////////////////////////
+// Minimal check macro for the host tests.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CHECK_HPP
+#define CHECK_HPP
+
+#include <cstdio>
+
+inline int check_failures{0};
+
+#define CHECK(condition)                                                       \
+    do                                                                         \
+    {                                                                          \
+        if(!(condition))                                                       \
+        {                                                                      \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,       \
+                #condition);                                                   \
+            ++check_failures;                                                  \
+        }                                                                      \
+    } while(false)
+
+inline int check_result(const char* const name)
+{
+    std::printf("%s: %s\n", name, (check_failures == 0) ? "ok" : "FAILED");
+    return (check_failures == 0) ? 0 : 1;
+}
+
+#endif   // CHECK_HPP
@@ -0,0 +1,210 @@
+////////////////////////////////////////////////////////////////////////////////
+// Host stand-in for the SPI peripheral, LL drivers and core registers.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "spi_model.hpp"
+
+#include "stm32f4xx_ll_dma.h"
+#include "stm32f4xx_ll_gpio.h"
+#include "stm32f4xx_ll_spi.h"
+
+#include <cstdint>
+#include <mutex>
+
+
+SPI_TypeDef spi_ports[5]{};
+RCC_TypeDef rcc{};
+DWT_Type dwt{};
+CoreDebug_Type core_debug{};
+SpiModel spi_model{};
+
+// interrupts are masked per thread, and masking them excludes other threads
+static thread_local std::uint32_t primask{0};
+static std::mutex masked{};
+
+// bytes reach the model one at a time, however many threads send
+static std::mutex wire{};
+
+static std::uint32_t dma_length{0};
+static std::uint32_t dma_address{0};
+
+
+std::size_t SpiModel::commands() const
+{
+    std::size_t n{0};
+    for(const auto& b : log)
+        n += b.data ? 0U : 1U;
+
+    return n;
+}
+
+std::size_t SpiModel::data() const
+{
+    return log.size() - commands();
+}
+
+void SpiModel::clear()
+{
+    log.clear();
+}
+
+void SpiModel::stall(const std::size_t after, const std::uint32_t polls)
+{
+    stall_at    = sent + after;
+    stall_polls = polls;
+}
+
+
+static void tick()
+{
+    dwt.CYCCNT = dwt.CYCCNT + spi_model.poll_cycles;
+}
+
+static void transmit(const std::uint8_t data)
+{
+    const std::lock_guard<std::mutex> lock{wire};
+
+    const bool dc{(spi_model.dc_port != nullptr) &&
+                  ((spi_model.dc_port->ODR & spi_model.dc_pin) != 0U)};
+
+    std::size_t selected{0};
+    for(const auto& s : spi_model.selects)
+        selected += ((s.port->ODR & s.pin) == 0U) ? 1U : 0U;
+
+    if(!spi_model.selects.empty() && (selected != 1U))
+        ++spi_model.collisions;
+
+    spi_model.log.push_back({dc, data});
+    ++spi_model.sent;
+}
+
+
+std::uint32_t __get_PRIMASK()
+{
+    return primask;
+}
+
+void __set_PRIMASK(const std::uint32_t mask)
+{
+    if((primask == 0U) && (mask != 0U))
+        masked.lock();
+    else if((primask != 0U) && (mask == 0U))
+        masked.unlock();
+
+    primask = mask;
+}
+
+void __disable_irq()
+{
+    __set_PRIMASK(1U);
+}
+
+
+void LL_SPI_Enable(SPI_TypeDef* const spi)
+{
+    spi->CR1 = spi->CR1 | 0x40U;
+}
+
+void LL_SPI_Disable(SPI_TypeDef* const spi)
+{
+    spi->CR1 = spi->CR1 & ~0x40U;
+}
+
+void LL_SPI_TransmitData8(SPI_TypeDef* const spi, const std::uint8_t data)
+{
+    spi->DR = data;
+    transmit(data);
+}
+
+std::uint32_t LL_SPI_IsActiveFlag_TXE(SPI_TypeDef*)
+{
+    tick();
+
+    if((spi_model.stall_polls != 0U) && (spi_model.sent >= spi_model.stall_at))
+    {
+        --spi_model.stall_polls;
+        return 0U;
+    }
+
+    return 1U;
+}
+
+std::uint32_t LL_SPI_IsActiveFlag_BSY(SPI_TypeDef*)
+{
+    tick();
+    return 0U;
+}
+
+void LL_SPI_EnableIT_TXE(SPI_TypeDef* const spi)
+{
+    spi->CR2 = spi->CR2 | SPI_CR2_TXEIE;
+    spi_model.txe_interrupt = true;
+}
+
+void LL_SPI_DisableIT_TXE(SPI_TypeDef* const spi)
+{
+    spi->CR2 = spi->CR2 & ~SPI_CR2_TXEIE;
+    spi_model.txe_interrupt = false;
+}
+
+void LL_SPI_EnableDMAReq_TX(SPI_TypeDef* const spi)
+{
+    spi->CR2 = spi->CR2 | SPI_CR2_TXDMAEN;
+}
+
+void LL_SPI_DisableDMAReq_TX(SPI_TypeDef* const spi)
+{
+    spi->CR2 = spi->CR2 & ~SPI_CR2_TXDMAEN;
+}
+
+std::uint32_t LL_SPI_DMA_GetRegAddr(SPI_TypeDef*)
+{
+    return 0U;
+}
+
+
+void LL_DMA_DisableStream(DMA_TypeDef*, std::uint32_t)
+{
+}
+
+void LL_DMA_EnableStream(DMA_TypeDef*, std::uint32_t)
+{
+    // the library passes a 32-bit address; on a 64-bit host the upper half
+    // is taken from the static data the bus lives in
+    const auto base = reinterpret_cast<std::uintptr_t>(&spi_model);
+    const auto* const source = reinterpret_cast<const std::uint8_t*>(
+        (base & ~std::uintptr_t{0xFFFFFFFFU}) | dma_address);
+
+    for(std::uint32_t n{}; n != dma_length; ++n)
+        transmit(*source);
+}
+
+std::uint32_t LL_DMA_IsEnabledStream(DMA_TypeDef*, std::uint32_t)
+{
+    tick();
+    return 0U;
+}
+
+void LL_DMA_SetChannelSelection(DMA_TypeDef*, std::uint32_t, std::uint32_t)
+{
+}
+
+void LL_DMA_ConfigTransfer(DMA_TypeDef*, std::uint32_t, std::uint32_t)
+{
+}
+
+void LL_DMA_SetPeriphAddress(DMA_TypeDef*, std::uint32_t, std::uint32_t)
+{
+}
+
+void LL_DMA_SetMemoryAddress(
+    DMA_TypeDef*, std::uint32_t, const std::uint32_t address)
+{
+    dma_address = address;
+}
+
+void LL_DMA_SetDataLength(
+    DMA_TypeDef*, std::uint32_t, const std::uint32_t length)
+{
+    dma_length = length;
+}
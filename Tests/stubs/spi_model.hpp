@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+// Host stand-in for the SPI peripheral. Every byte written to the data
+// register is logged with the level of the mode select pin. Each flag poll
+// advances the cycle counter, and stalls can be injected to hold the transmit
+// buffer empty flag low. Masking interrupts takes a lock shared by all
+// threads, as on a single core, so threads can stand in for RTOS tasks.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SPI_MODEL_HPP
+#define SPI_MODEL_HPP
+
+#include "stm32f411xe.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+struct SpiModel
+{
+    struct Byte
+    {
+        bool data{false};
+        std::uint8_t value{0};
+    };
+
+    struct Select
+    {
+        GPIO_TypeDef* port{nullptr};
+        std::uint32_t pin{0};
+    };
+
+    // mode select pin, read when logging a byte
+    GPIO_TypeDef* dc_port{nullptr};
+    std::uint32_t dc_pin{0};
+
+    std::vector<Byte> log{};
+    std::size_t sent{0};
+
+    // cycles that pass on every flag poll
+    std::uint32_t poll_cycles{8};
+
+    // hold TXE low for stall_polls polls once stall_at bytes have been sent
+    std::size_t stall_at{0};
+    std::uint32_t stall_polls{0};
+
+    // true while the TXE interrupt is enabled
+    bool txe_interrupt{false};
+
+    // chip enable pins, active low; bytes sent with other than exactly one
+    // of them selected are counted as collisions
+    std::vector<Select> selects{};
+    std::size_t collisions{0};
+
+    std::size_t commands() const;
+    std::size_t data() const;
+    void clear();
+    void stall(std::size_t after, std::uint32_t polls);
+};
+
+extern SpiModel spi_model;
+
+#endif   // SPI_MODEL_HPP
@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+// Host stand-in for the CMSIS device header: just the registers and core
+// functions the library uses, backed by the SPI model.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STM32F411XE_H
+#define STM32F411XE_H
+
+#include <cstdint>
+
+struct SPI_TypeDef
+{
+    volatile std::uint32_t CR1;
+    volatile std::uint32_t CR2;
+    volatile std::uint32_t SR;
+    volatile std::uint32_t DR;
+};
+
+struct GPIO_TypeDef
+{
+    volatile std::uint32_t ODR;
+};
+
+struct DMA_TypeDef
+{
+    volatile std::uint32_t LISR;
+    volatile std::uint32_t HISR;
+    volatile std::uint32_t LIFCR;
+    volatile std::uint32_t HIFCR;
+};
+
+struct RCC_TypeDef
+{
+    volatile std::uint32_t APB1RSTR;
+    volatile std::uint32_t APB2RSTR;
+};
+
+struct DWT_Type
+{
+    volatile std::uint32_t CTRL;
+    volatile std::uint32_t CYCCNT;
+};
+
+struct CoreDebug_Type
+{
+    volatile std::uint32_t DEMCR;
+};
+
+extern SPI_TypeDef spi_ports[5];
+extern RCC_TypeDef rcc;
+extern DWT_Type dwt;
+extern CoreDebug_Type core_debug;
+
+#define SPI1 (&spi_ports[0])
+#define SPI2 (&spi_ports[1])
+#define SPI3 (&spi_ports[2])
+#define SPI4 (&spi_ports[3])
+#define SPI5 (&spi_ports[4])
+#define RCC (&rcc)
+#define DWT (&dwt)
+#define CoreDebug (&core_debug)
+
+#define RCC_APB1RSTR_SPI2RST (1U << 14)
+#define RCC_APB1RSTR_SPI3RST (1U << 15)
+#define RCC_APB2RSTR_SPI1RST (1U << 12)
+#define RCC_APB2RSTR_SPI4RST (1U << 13)
+#define RCC_APB2RSTR_SPI5RST (1U << 20)
+#define SPI_CR2_TXDMAEN (1U << 1)
+#define SPI_CR2_TXEIE (1U << 7)
+#define CoreDebug_DEMCR_TRCENA_Msk (1U << 24)
+#define DWT_CTRL_CYCCNTENA_Msk (1U << 0)
+
+std::uint32_t __get_PRIMASK();
+void __set_PRIMASK(std::uint32_t primask);
+void __disable_irq();
+
+#endif   // STM32F411XE_H
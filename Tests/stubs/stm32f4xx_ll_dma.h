@@ -0,0 +1,35 @@
+////////////////////////////////////////////////////////////////////////////////
+// Host stand-in for the LL DMA driver, backed by the SPI model. Streams
+// complete as soon as they are enabled.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STM32F4XX_LL_DMA_H
+#define STM32F4XX_LL_DMA_H
+
+#include "stm32f411xe.h"
+
+#define LL_DMA_DIRECTION_MEMORY_TO_PERIPH 0x00000040U
+#define LL_DMA_MODE_NORMAL 0x00000000U
+#define LL_DMA_PERIPH_NOINCREMENT 0x00000000U
+#define LL_DMA_MEMORY_NOINCREMENT 0x00000000U
+#define LL_DMA_PDATAALIGN_BYTE 0x00000000U
+#define LL_DMA_MDATAALIGN_BYTE 0x00000000U
+#define LL_DMA_PRIORITY_LOW 0x00000000U
+#define LL_DMA_STREAM_4 4U
+#define LL_DMA_CHANNEL_0 0x00000000U
+
+void LL_DMA_DisableStream(DMA_TypeDef* dma, std::uint32_t stream);
+void LL_DMA_EnableStream(DMA_TypeDef* dma, std::uint32_t stream);
+std::uint32_t LL_DMA_IsEnabledStream(DMA_TypeDef* dma, std::uint32_t stream);
+void LL_DMA_SetChannelSelection(
+    DMA_TypeDef* dma, std::uint32_t stream, std::uint32_t channel);
+void LL_DMA_ConfigTransfer(
+    DMA_TypeDef* dma, std::uint32_t stream, std::uint32_t configuration);
+void LL_DMA_SetPeriphAddress(
+    DMA_TypeDef* dma, std::uint32_t stream, std::uint32_t address);
+void LL_DMA_SetMemoryAddress(
+    DMA_TypeDef* dma, std::uint32_t stream, std::uint32_t address);
+void LL_DMA_SetDataLength(
+    DMA_TypeDef* dma, std::uint32_t stream, std::uint32_t length);
+
+#endif   // STM32F4XX_LL_DMA_H
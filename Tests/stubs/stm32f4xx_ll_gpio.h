@@ -0,0 +1,20 @@
+////////////////////////////////////////////////////////////////////////////////
+// Host stand-in for the LL GPIO driver.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STM32F4XX_LL_GPIO_H
+#define STM32F4XX_LL_GPIO_H
+
+#include "stm32f411xe.h"
+
+inline void LL_GPIO_SetOutputPin(GPIO_TypeDef* port, std::uint32_t pins)
+{
+    port->ODR = port->ODR | pins;
+}
+
+inline void LL_GPIO_ResetOutputPin(GPIO_TypeDef* port, std::uint32_t pins)
+{
+    port->ODR = port->ODR & ~pins;
+}
+
+#endif   // STM32F4XX_LL_GPIO_H
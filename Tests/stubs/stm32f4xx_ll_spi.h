@@ -0,0 +1,21 @@
+////////////////////////////////////////////////////////////////////////////////
+// Host stand-in for the LL SPI driver, backed by the SPI model.
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef STM32F4XX_LL_SPI_H
+#define STM32F4XX_LL_SPI_H
+
+#include "stm32f411xe.h"
+
+void LL_SPI_Enable(SPI_TypeDef* spi);
+void LL_SPI_Disable(SPI_TypeDef* spi);
+void LL_SPI_TransmitData8(SPI_TypeDef* spi, std::uint8_t data);
+std::uint32_t LL_SPI_IsActiveFlag_TXE(SPI_TypeDef* spi);
+std::uint32_t LL_SPI_IsActiveFlag_BSY(SPI_TypeDef* spi);
+void LL_SPI_EnableIT_TXE(SPI_TypeDef* spi);
+void LL_SPI_DisableIT_TXE(SPI_TypeDef* spi);
+void LL_SPI_EnableDMAReq_TX(SPI_TypeDef* spi);
+void LL_SPI_DisableDMAReq_TX(SPI_TypeDef* spi);
+std::uint32_t LL_SPI_DMA_GetRegAddr(SPI_TypeDef* spi);
+
+#endif   // STM32F4XX_LL_SPI_H
@@ -0,0 +1,74 @@
+////////////////////////////////////////////////////////////////////////////////
+// Two displays on one bus, each driven from its own thread standing in for an
+// RTOS task: no byte goes out while the other display is selected, nothing is
+// lost, and a transfer that cannot be queued is reported.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "check.hpp"
+#include "spi_model.hpp"
+
+#include "pcd8544.hpp"
+#include "spi_bus.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+
+static GPIO_TypeDef sce_ports[2]{};
+static GPIO_TypeDef rst_ports[2]{};
+static GPIO_TypeDef dc_port{};
+static constexpr std::uint32_t sce_pin{1U};
+static constexpr std::uint32_t rst_pin{2U};
+static constexpr std::uint32_t dc_pin{4U};
+
+static SpiBus bus{SPI1};
+static std::array<std::uint8_t, PCD8544::screen_width * PCD8544::banks> bmp{};
+
+static constexpr int draws{200};
+
+
+static void draw(PCD8544& lcd)
+{
+    for(int n{}; n != draws; ++n)
+    {
+        lcd.draw_bitmap(bmp);
+        lcd.set_contrast(n & 0x7F);
+    }
+}
+
+
+int main()
+{
+    // the displays share the mode select line
+    spi_model.dc_port = &dc_port;
+    spi_model.dc_pin  = dc_pin;
+
+    PCD8544 first{bus, &sce_ports[0], sce_pin, &rst_ports[0], rst_pin,
+        &dc_port, dc_pin};
+    PCD8544 second{bus, &sce_ports[1], sce_pin, &rst_ports[1], rst_pin,
+        &dc_port, dc_pin};
+
+    spi_model.selects = {{&sce_ports[0], sce_pin}, {&sce_ports[1], sce_pin}};
+    spi_model.clear();
+
+    std::thread task{draw, std::ref(first)};
+    draw(second);
+    task.join();
+
+    CHECK(spi_model.collisions == 0U);
+    CHECK(spi_model.data() == 2U * draws * bmp.size());
+    CHECK(bus.pending(0) == 0);
+    CHECK(bus.pending(1) == 0);
+
+    // a device that is not attached never gets its transaction out
+    static constexpr std::array<std::uint8_t, 1> command{0x20U};
+    const std::size_t sent{spi_model.sent};
+    CHECK(bus.transfer(0, {command}));
+    CHECK(!bus.transfer(2, {command}));
+    CHECK(!bus.transfer(-1, {command}));
+    CHECK(spi_model.sent == sent + 1U);
+
+    return check_result("test_bus_sharing");
+}
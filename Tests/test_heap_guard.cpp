@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////////////////////////
+// Every public drawing path run under a HeapGuard, built with
+// PCD8544_HEAP_GUARD so the counting operator new and delete are linked in.
+// Fails if any of them allocates, and checks that allocations are counted.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "check.hpp"
+#include "spi_model.hpp"
+
+#include "compositor.hpp"
+#include "display_queue.hpp"
+#include "display_task.hpp"
+#include "dither.hpp"
+#include "font.hpp"
+#include "font_6x8.hpp"
+#include "grayscale.hpp"
+#include "heap_guard.hpp"
+#include "numeric_field.hpp"
+#include "pcd8544.hpp"
+#include "spi_bus.hpp"
+#include "sprite.hpp"
+#include "static_screen.hpp"
+#include "strip_chart.hpp"
+#include "strip_renderer.hpp"
+#include "viewport.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+
+static GPIO_TypeDef sce_port{};
+static GPIO_TypeDef rst_port{};
+static GPIO_TypeDef dc_port{};
+static constexpr std::uint32_t sce_pin{1U};
+static constexpr std::uint32_t rst_pin{2U};
+static constexpr std::uint32_t dc_pin{4U};
+
+static constexpr std::size_t screen_size{
+    PCD8544::screen_width * PCD8544::banks};
+
+static SpiBus bus{SPI1};
+static std::array<std::uint8_t, screen_size> bmp{};
+static std::array<std::uint8_t, screen_size> fb{};
+static std::array<std::uint8_t, screen_size> layer_pixels{};
+static std::array<std::uint8_t, screen_size> msb{};
+static std::array<std::uint8_t, screen_size> lsb{};
+static std::array<std::uint8_t,
+    PCD8544::screen_width * PCD8544::screen_height / 4>
+    gray4{};
+static std::array<std::uint8_t, 32U * 16U> gray8{};
+static constexpr std::array<std::uint8_t, 8> sprite_image{
+    0x3CU, 0x42U, 0x81U, 0x81U, 0x81U, 0x81U, 0x42U, 0x3CU};
+
+static constexpr auto splash =
+    StaticScreen{}.text(0, 0, "splash", font_6x8).pixels();
+
+// keeps deliberate allocations from being optimised away
+static void* volatile sink{nullptr};
+
+struct alignas(64) Aligned
+{
+    std::array<std::uint8_t, 64> bytes{};
+};
+
+
+static DisplayTask flush_task(PCD8544& lcd)
+{
+    co_await lcd.flush_async();
+}
+
+
+static DisplayTask bitmap_task(PCD8544& lcd)
+{
+    co_await lcd.draw_bitmap_async(bmp);
+}
+
+
+static void immediate(PCD8544& lcd)
+{
+    GlyphCache cache{};
+
+    lcd.set_contrast(60);
+    lcd.clear();
+    lcd.set_cursor(0, 0);
+    lcd.print('A');
+    lcd.print("hello\nworld\t!");
+    lcd.print_utf8("caf\xC3\xA9 \xE2\x82\xAC");
+    lcd.write('x');
+    lcd.set_ram_addr(10, 2);
+    lcd.set_pixels(0x81U);
+    lcd.draw_bitmap(bmp);
+    lcd.draw_bitmap(5, 1, 20, 2, bmp, PCD8544::screen_width);
+    lcd.draw_columns(30, 0, 2, std::span{bmp}.first(20));
+    lcd.draw_text(3, 1, "proportional", font_6x8_proportional);
+    lcd.set_glyph_cache(&cache);
+    lcd.draw_text(0, 2, "x2", 2);
+    lcd.draw_text(0, 3, "x3", 3);
+    lcd.set_glyph_cache(nullptr);
+    lcd.fill(4, 4, 40, 2, 0x55U);
+    lcd.set_addressing(PCD8544::Addressing::vertical);
+    lcd.set_addressing(PCD8544::Addressing::horizontal);
+
+    for(const auto orientation : {PCD8544::Orientation::rotate_180,
+            PCD8544::Orientation::mirror_x, PCD8544::Orientation::mirror_y,
+            PCD8544::Orientation::normal})
+    {
+        lcd.set_orientation(orientation);
+        lcd.print("turn");
+        lcd.draw_bitmap(7, 2, 9, 3, bmp, PCD8544::screen_width);
+    }
+
+    auto task = bitmap_task(lcd);
+    bus.drain();
+    CHECK(task.done());
+
+    lcd.set_idle_timeout(100U, true);
+    lcd.tick(10U);
+    lcd.tick(500U);
+    lcd.print("wake");
+    lcd.set_idle_timeout(0U);
+}
+
+
+static void buffered(PCD8544& lcd)
+{
+    lcd.set_frame_buffer(fb);
+    lcd.set_frame_rate(30);
+    lcd.print("frame");
+    lcd.draw_text(0, 3, "buffer", font_6x8);
+    lcd.fill(0, 5, 84, 1, 0xF0U);
+    lcd.flush();
+    lcd.tick(1000U);
+
+    lcd.draw_bitmap(0, 0, 16, 2, bmp, PCD8544::screen_width);
+    auto task = flush_task(lcd);
+    bus.drain();
+    CHECK(task.done());
+
+    lcd.set_frame_buffer({});
+}
+
+
+static void widgets(PCD8544& lcd)
+{
+    std::array<Sprite, 2> sprites{Sprite{sprite_image, 8, 8},
+        Sprite{sprite_image, 8, 8, sprite_image}};
+    SpriteEngine engine{lcd, bmp, sprites};
+    sprites[0].set_visible(true);
+    sprites[1].set_visible(true);
+    engine.redraw();
+    for(int n{}; n != 4; ++n)
+    {
+        sprites[0].move_to(n * 5, n * 3);
+        sprites[1].move_to(60 - (n * 4), 20);
+        engine.update();
+    }
+
+    const std::array<DisplayItem, 3> items{
+        display_rect(0, 0, 84, 48, RasterOp::mask),
+        display_text(2, 5, "strips", font_6x8),
+        display_bitmap(40, 13, 8, 8, sprite_image, RasterOp::bit_xor)};
+    StripRenderer renderer{lcd};
+    renderer.render(items);
+    renderer.render(items, 2, 3);
+
+    std::array<Layer, 2> layers{
+        Layer{std::span<std::uint8_t, Layer::size>{layer_pixels}},
+        Layer{std::span<const std::uint8_t, Layer::size>{bmp},
+            RasterOp::bit_xor}};
+    {
+        Compositor compositor{lcd, layers};
+        layers[0].draw_text(0, 0, "layer", font_6x8);
+        layers[0].draw_bitmap(30, 2, 8, 1, sprite_image, 8);
+        layers[0].set_pixels(80, 5, 0xFFU);
+        compositor.flush();
+        layers[1].set_visible(false);
+        compositor.flush();
+        compositor.invalidate();
+        compositor.flush();
+    }
+
+    Viewport viewport{lcd, 6, 1, 48, 3};
+    viewport.set_wrap(true);
+    viewport.set_scroll(true);
+    viewport.print("a viewport that wraps and scrolls\nover lines");
+    viewport.set_cursor(1, 1);
+    viewport.print('z');
+    viewport.redraw();
+    viewport.clear();
+
+    NumericField integer{lcd, 0, 5, 6};
+    NumericField real{lcd, 7, 5, 7, 2};
+    integer.update(-12345L);
+    integer.update(42L);
+    real.update(3.14159F);
+    real.update(-0.5F);
+    real.invalidate();
+    real.update(-0.5F);
+
+    StripChart scroll{lcd, 0, 0, 40, 2};
+    StripChart sweep{lcd, 44, 2, 40, 3, StripChart::Mode::sweep};
+    for(int n{}; n != 60; ++n)
+    {
+        scroll.push((n * 7) % 100);
+        sweep.push((n * 11) % 100);
+    }
+    scroll.redraw();
+    sweep.clear();
+}
+
+
+static void images(PCD8544& lcd)
+{
+    for(std::size_t n{}; n != gray8.size(); ++n)
+        gray8[n] = static_cast<std::uint8_t>(n);
+
+    Dither ordered{gray8, 32, 16, Dither::Method::ordered};
+    ordered.draw(lcd, 0, 0);
+
+    Dither diffused{gray8, 32, 16, Dither::Method::error_diffusion};
+    std::array<std::uint8_t, 32> row{};
+    while(diffused.next(row))
+        ;
+    diffused.reset();
+    diffused.draw(lcd, 40, 2);
+
+    for(std::size_t n{}; n != gray4.size(); ++n)
+        gray4[n] = static_cast<std::uint8_t>(n * 37U);
+
+    split_planes(gray4, msb, lsb);
+    Grayscale grayscale{lcd, msb, lsb};
+    for(int n{}; n != Grayscale::subframes * 2; ++n)
+        grayscale.step();
+    grayscale.set_image(lsb, msb);
+    grayscale.step();
+
+    lcd.draw_bitmap(splash);
+}
+
+
+static void queued(PCD8544& lcd)
+{
+    DisplayQueue queue{lcd};
+    queue.clear();
+    queue.print(0, 0, "queued");
+    queue.draw_text(0, 2, "text");
+    queue.draw_bitmap(40, 1, 8, 1, sprite_image, 8);
+    queue.set_contrast(55);
+    CHECK(queue.process() == 5);
+}
+
+
+int main()
+{
+    spi_model.dc_port = &dc_port;
+    spi_model.dc_pin  = dc_pin;
+
+    // the model's own byte log must not count against the library
+    spi_model.log.reserve(1U << 20U);
+
+    for(std::size_t n{}; n != bmp.size(); ++n)
+        bmp[n] = static_cast<std::uint8_t>(n * 13U);
+
+    const HeapGuard guard{};
+
+    PCD8544 lcd{bus, &sce_port, sce_pin, &rst_port, rst_pin, &dc_port, dc_pin};
+    PCD8544 second{bus, &sce_port, sce_pin, &rst_port, rst_pin, &dc_port,
+        dc_pin, splash};
+
+    immediate(lcd);
+    buffered(lcd);
+    widgets(lcd);
+    images(lcd);
+    queued(lcd);
+    second.print("second");
+
+    CHECK(spi_model.data() != 0U);
+    CHECK(guard.clean());
+    if(!guard.clean())
+        std::printf("%u allocations\n", guard.allocations());
+
+    // the guard sees plain and over-aligned allocations
+    const HeapGuard counted{};
+    sink = new int{1};
+    delete static_cast<int*>(sink);
+    sink = new Aligned{};
+    delete static_cast<Aligned*>(sink);
+    sink = new(std::nothrow) Aligned[2];
+    delete[] static_cast<Aligned*>(sink);
+    CHECK(counted.allocations() == 3U);
+    CHECK(heap_stats().frees >= 3U);
+
+    return check_result("test_heap_guard");
+}
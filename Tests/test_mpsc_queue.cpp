@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////
+// Multi-producer stress of MpscQueue and DisplayQueue with real threads: no
+// element is lost or duplicated, each producer's elements come out in the
+// order it pushed them, and push latency under contention is reported for one
+// to eight producers.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "check.hpp"
+#include "spi_model.hpp"
+
+#include "display_queue.hpp"
+#include "mpsc_queue.hpp"
+#include "pcd8544.hpp"
+#include "spi_bus.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <span>
+#include <thread>
+#include <vector>
+
+
+static GPIO_TypeDef sce_port{};
+static GPIO_TypeDef rst_port{};
+static GPIO_TypeDef dc_port{};
+static constexpr std::uint32_t sce_pin{1U};
+static constexpr std::uint32_t rst_pin{2U};
+static constexpr std::uint32_t dc_pin{4U};
+
+static SpiBus bus{SPI1};
+
+static constexpr std::uint32_t producers{4U};
+static constexpr std::uint32_t max_producers{8U};
+static constexpr std::uint32_t per_producer{20000U};
+
+struct Item
+{
+    std::uint32_t producer{0};
+    std::uint32_t sequence{0};
+};
+
+// push latency in power of two nanosecond buckets
+struct Latency
+{
+    std::uint64_t worst{0};
+    std::array<std::uint32_t, 32> histogram{};
+
+    void add(const std::uint64_t ns)
+    {
+        worst = std::max(worst, ns);
+        const auto width  = static_cast<std::size_t>(std::bit_width(ns));
+        const auto bucket = std::min(width, histogram.size() - 1U);
+        ++histogram[bucket];
+    }
+
+    void merge(const Latency& other)
+    {
+        worst = std::max(worst, other.worst);
+        for(std::size_t n{}; n != histogram.size(); ++n)
+            histogram[n] += other.histogram[n];
+    }
+};
+
+// small, so producers keep running into a full queue and each other
+static MpscQueue<Item, 8> queue{};
+
+
+static void print_latency(const std::uint32_t count, const Latency& latency)
+{
+    std::printf("push latency, %u producers, worst %llu ns:\n", count,
+        static_cast<unsigned long long>(latency.worst));
+    for(std::size_t n{}; n != latency.histogram.size(); ++n)
+    {
+        if(latency.histogram[n] != 0U)
+            std::printf("  < %7llu ns: %u\n", 1ULL << n, latency.histogram[n]);
+    }
+}
+
+
+static void produce(const std::uint32_t id, Latency& latency)
+{
+    using clock = std::chrono::steady_clock;
+
+    for(std::uint32_t n{}; n != per_producer; ++n)
+    {
+        // every attempt is timed, including those that find the queue full
+        for(;;)
+        {
+            const auto start = clock::now();
+            const bool pushed{queue.push({id, n})};
+            const auto ns    = std::chrono::duration_cast<
+                std::chrono::nanoseconds>(clock::now() - start);
+
+            latency.add(static_cast<std::uint64_t>(ns.count()));
+            if(pushed)
+                break;
+
+            std::this_thread::yield();
+        }
+    }
+}
+
+
+static void test_mpsc_queue(const std::uint32_t count)
+{
+    std::array<Latency, max_producers> latencies{};
+    std::vector<std::thread> threads{};
+    for(std::uint32_t id{}; id != count; ++id)
+        threads.emplace_back(produce, id, std::ref(latencies[id]));
+
+    std::array<std::uint32_t, max_producers> next{};
+    std::uint32_t received{0};
+    std::uint32_t out_of_order{0};
+    Item item{};
+
+    while(received != count * per_producer)
+    {
+        if(!queue.pop(item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        CHECK(item.producer < count);
+        if(item.producer >= count)
+            break;
+
+        if(item.sequence != next[item.producer])
+            ++out_of_order;
+
+        next[item.producer] = item.sequence + 1U;
+        ++received;
+    }
+
+    for(auto& t : threads)
+        t.join();
+
+    CHECK(out_of_order == 0U);
+    CHECK(received == count * per_producer);
+    for(std::uint32_t id{}; id != count; ++id)
+        CHECK(next[id] == per_producer);
+    CHECK(!queue.pop(item));
+
+    Latency total{};
+    for(std::uint32_t id{}; id != count; ++id)
+        total.merge(latencies[id]);
+    print_latency(count, total);
+}
+
+
+static void test_display_queue(PCD8544& lcd)
+{
+    // each command draws one byte: the producer in the top two bits and the
+    // sequence number, modulo 64, below
+    static std::array<std::uint8_t, 256> bytes{};
+    for(std::size_t n{}; n != bytes.size(); ++n)
+        bytes[n] = static_cast<std::uint8_t>(n);
+
+    DisplayQueue display{lcd};
+    std::atomic<std::uint32_t> finished{0U};
+    constexpr std::uint32_t commands{5000U};
+
+    const auto produce_commands = [&](const std::uint32_t id)
+    {
+        for(std::uint32_t n{}; n != commands; ++n)
+        {
+            const auto byte = std::span{bytes}.subspan((id << 6U) | (n & 63U));
+            while(!display.draw_bitmap(0, 0, 1, 1, byte.first(1), 1))
+                std::this_thread::yield();
+        }
+
+        finished.fetch_add(1U);
+    };
+
+    spi_model.clear();
+
+    std::vector<std::thread> threads{};
+    for(std::uint32_t id{}; id != producers; ++id)
+        threads.emplace_back(produce_commands, id);
+
+    std::uint32_t processed{0};
+    while(finished.load() != producers)
+    {
+        // bounded however fast the producers refill the queue
+        const int n{display.process()};
+        CHECK(n <= static_cast<int>(DisplayQueue::capacity));
+        processed += static_cast<std::uint32_t>(n);
+        if(n == 0)
+            std::this_thread::yield();
+    }
+
+    for(auto& t : threads)
+        t.join();
+
+    while(const int n{display.process()})
+        processed += static_cast<std::uint32_t>(n);
+    CHECK(processed == producers * commands);
+    CHECK(spi_model.data() == producers * commands);
+
+    std::array<std::uint32_t, producers> next{};
+    std::uint32_t out_of_order{0};
+    for(const auto& b : spi_model.log)
+    {
+        if(!b.data)
+            continue;
+
+        auto& expected = next[b.value >> 6U];
+        if((b.value & 63U) != (expected & 63U))
+            ++out_of_order;
+
+        ++expected;
+    }
+
+    CHECK(out_of_order == 0U);
+    for(const auto n : next)
+        CHECK(n == commands);
+}
+
+
+int main()
+{
+    spi_model.dc_port = &dc_port;
+    spi_model.dc_pin  = dc_pin;
+
+    PCD8544 lcd{bus, &sce_port, sce_pin, &rst_port, rst_pin, &dc_port, dc_pin};
+
+    for(const std::uint32_t count : {1U, 2U, 4U, 8U})
+        test_mpsc_queue(count);
+    test_display_queue(lcd);
+
+    return check_result("test_mpsc_queue");
+}
@@ -0,0 +1,111 @@
+////////////////////////////////////////////////////////////////////////////////
+// NumericField with the argument types callers actually have: plain int and
+// double readings as well as long, float and other integer types, checked
+// against the glyphs that land in the frame buffer.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "check.hpp"
+#include "spi_model.hpp"
+
+#include "font_6x8.hpp"
+#include "numeric_field.hpp"
+#include "pcd8544.hpp"
+#include "spi_bus.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+
+static GPIO_TypeDef sce_port{};
+static GPIO_TypeDef rst_port{};
+static GPIO_TypeDef dc_port{};
+static constexpr std::uint32_t sce_pin{1U};
+static constexpr std::uint32_t rst_pin{2U};
+static constexpr std::uint32_t dc_pin{4U};
+
+static SpiBus bus{SPI1};
+static std::array<std::uint8_t, PCD8544::screen_width * PCD8544::banks> fb{};
+
+
+// true if the frame buffer shows s in the built-in font at a cell position
+static bool shows(const int column, const int bank, const std::string_view s)
+{
+    int x{column * font_6x8.width};
+
+    for(const auto c : s)
+    {
+        const auto glyph = font_6x8.glyph(static_cast<unsigned char>(c));
+        const auto at    = fb.begin() + (bank * PCD8544::screen_width) + x;
+
+        if(!std::equal(glyph.begin(), glyph.end(), at))
+            return false;
+
+        x += font_6x8.width;
+    }
+
+    return true;
+}
+
+
+int main()
+{
+    spi_model.dc_port = &dc_port;
+    spi_model.dc_pin  = dc_pin;
+
+    PCD8544 lcd{bus, &sce_port, sce_pin, &rst_port, rst_pin, &dc_port, dc_pin};
+    lcd.set_frame_buffer(fb);
+
+    NumericField integer{lcd, 0, 0, 6};
+    NumericField real{lcd, 0, 1, 7, 2};
+
+    const int rpm{1234};
+    integer.update(rpm);
+    CHECK(shows(0, 0, "  1234"));
+
+    integer.update(-42);
+    CHECK(shows(0, 0, "   -42"));
+
+    integer.update(56789L);
+    CHECK(shows(0, 0, " 56789"));
+
+    integer.update(7U);
+    CHECK(shows(0, 0, "     7"));
+
+    const short small{-5};
+    integer.update(small);
+    CHECK(shows(0, 0, "    -5"));
+
+    integer.update(std::numeric_limits<unsigned long long>::max());
+    CHECK(shows(0, 0, "######"));
+
+    integer.update(1234567);
+    CHECK(shows(0, 0, "######"));
+
+    const double volts{3.5};
+    real.update(volts);
+    CHECK(shows(0, 1, "   3.50"));
+
+    real.update(-0.256);
+    CHECK(shows(0, 1, "  -0.26"));
+
+    real.update(12.345F);
+    CHECK(shows(0, 1, "  12.35"));
+
+    real.update(std::nan(""));
+    CHECK(shows(0, 1, "#######"));
+
+    real.update(-HUGE_VAL);
+    CHECK(shows(0, 1, "#######"));
+
+    real.update(1.0e30);
+    CHECK(shows(0, 1, "#######"));
+
+    real.update(0.0);
+    CHECK(shows(0, 1, "   0.00"));
+
+    return check_result("test_numeric_field");
+}
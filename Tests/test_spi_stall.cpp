@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+// Bounded SPI waits: stall detection, peripheral reset, controller recovery
+// and the wait latency histogram, against the SPI model with injected stalls.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "check.hpp"
+#include "spi_model.hpp"
+
+#include "display_task.hpp"
+#include "pcd8544.hpp"
+#include "spi_bus.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+
+
+static GPIO_TypeDef sce_port{};
+static GPIO_TypeDef rst_port{};
+static GPIO_TypeDef dc_port{};
+static constexpr std::uint32_t sce_pin{1U};
+static constexpr std::uint32_t rst_pin{2U};
+static constexpr std::uint32_t dc_pin{4U};
+
+static SpiBus bus{SPI1};
+static std::array<std::uint8_t, PCD8544::screen_width * PCD8544::banks> bmp{};
+static std::array<std::uint8_t, PCD8544::screen_width * PCD8544::banks> fb{};
+
+// cycles per poll in the model, and a timeout of 100 polls
+static constexpr std::uint32_t timeout{800U};
+
+
+static DisplayTask flush_task(PCD8544& lcd)
+{
+    co_await lcd.flush_async();
+}
+
+
+static void print_histogram()
+{
+    const auto& stats = bus.wait_stats();
+
+    std::printf("wait latency, worst %u cycles:\n", stats.worst);
+    for(std::size_t n{}; n != stats.histogram.size(); ++n)
+    {
+        if(stats.histogram[n] != 0U)
+            std::printf("  < %7u cycles: %u\n", 1U << n, stats.histogram[n]);
+    }
+}
+
+
+int main()
+{
+    spi_model.dc_port = &dc_port;
+    spi_model.dc_pin  = dc_pin;
+
+    PCD8544 lcd{bus, &sce_port, sce_pin, &rst_port, rst_pin, &dc_port, dc_pin};
+    bus.set_timeout(timeout);
+
+    // normal traffic is timed but never stalls
+    CHECK(bus.wait_stats().stalls == 0U);
+    CHECK(bus.wait_stats().worst != 0U);
+    CHECK(bus.wait_stats().worst <= timeout);
+
+    // a slow byte within the timeout only shows up in the statistics
+    bus.reset_wait_stats();
+    spi_model.stall(10U, 50U);
+    lcd.draw_bitmap(bmp);
+    CHECK(bus.stalls(0) == 0U);
+    CHECK(bus.wait_stats().worst >= 50U * spi_model.poll_cycles);
+    CHECK(lcd.recoveries() == 0U);
+    print_histogram();
+
+    // a dead port stalls: the transaction is dropped, the peripheral reset
+    // with its configuration kept, and the controller reset and configured
+    const std::uint32_t cr1{SPI1->CR1};
+    spi_model.clear();
+    spi_model.stall(100U, 200U);
+    lcd.draw_bitmap(bmp);
+
+    CHECK(bus.stalls(0) == 1U);
+    CHECK(bus.wait_stats().stalls == 1U);
+    CHECK(lcd.recoveries() == 1U);
+    CHECK(SPI1->CR1 == cr1);
+    CHECK(spi_model.data() == 100U);
+
+    constexpr std::array<std::uint8_t, 6> configure{
+        0x21U, 0xC5U, 0x04U, 0x13U, 0x20U, 0x0CU};
+    CHECK(spi_model.log.size() >= 100U + configure.size());
+    for(std::size_t n{}; n != configure.size(); ++n)
+    {
+        CHECK(!spi_model.log[100U + n].data);
+        CHECK(spi_model.log[100U + n].value == configure[n]);
+    }
+
+    // later transfers go through
+    spi_model.clear();
+    lcd.draw_bitmap(bmp);
+    CHECK(spi_model.data() == bmp.size());
+    CHECK(bus.stalls(0) == 1U);
+
+    // a frame that stalls is sent again in full by the next flush
+    lcd.set_frame_buffer(fb);
+    lcd.flush();
+    lcd.fill(0, 0, PCD8544::screen_width, PCD8544::banks, 0x55U);
+    spi_model.stall(20U, 200U);
+    lcd.flush();
+    CHECK(lcd.recoveries() == 2U);
+
+    spi_model.clear();
+    lcd.flush();
+    CHECK(spi_model.data() == fb.size());
+
+    // a background transfer that stalls is aborted, its waiter resumed, and
+    // the controller recovered by the next tick
+    lcd.fill(0, 0, PCD8544::screen_width, PCD8544::banks, 0xAAU);
+    spi_model.stall(3U, 200U);
+    auto task = flush_task(lcd);
+    bus.drain();
+    CHECK(task.done());
+    CHECK(!bus.busy());
+    CHECK(bus.stalls(0) == 3U);
+
+    spi_model.clear();
+    lcd.tick(1000U);
+    CHECK(lcd.recoveries() == 3U);
+    CHECK(spi_model.data() == fb.size());
+
+    return check_result("test_spi_stall");
+}